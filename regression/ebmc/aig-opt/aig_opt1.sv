@@ -0,0 +1,17 @@
+module main(input clk, input [7:0] in);
+
+  reg [7:0] x, y;
+
+  initial x = 0;
+  initial y = 0;
+
+  always @(posedge clk) begin
+    x = x + in;
+    y = in + y;
+  end
+
+  // x and y are computed by different, but equivalent, adders
+  p0: assert property (x == y);
+  p1: assert property (x != 10);
+
+endmodule
@@ -0,0 +1,38 @@
+module sub(input clk, output reg [3:0] value);
+
+  reg flag;
+
+  initial value = 0;
+  initial flag = 0;
+
+  always @(posedge clk) begin
+    value = value + 1;
+    flag = !flag;
+  end
+
+  q0: assert property (value != 2);
+
+endmodule
+
+module main(input clk);
+
+  reg [7:0] counter;
+  wire [3:0] sub_value;
+  reg [1:0] phase;
+
+  initial counter = 0;
+  initial phase = 0;
+
+  always @(posedge clk) begin
+    counter = counter + 1;
+    phase = phase + 1;
+  end
+
+  sub s(clk, sub_value);
+
+  p0: assert property (counter != 3);
+  p1: assert property (counter != 20);
+  p2: assert property (phase != 2);
+  p3: assert property (counter == sub_value);
+
+endmodule
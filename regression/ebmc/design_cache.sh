@@ -0,0 +1,30 @@
+#!/bin/sh
+
+# Runs ebmc twice with a fresh design cache directory.
+# The first run fills the cache, the second run is the one
+# whose output is checked. Apart from the messages of the
+# front end, both runs must give the same output.
+
+ebmc=$1
+shift
+
+cache=$(mktemp -d)
+
+"$ebmc" --design-cache "$cache" "$@" > "$cache/uncached.out" 2>&1
+"$ebmc" --design-cache "$cache" "$@" > "$cache/cached.out" 2>&1
+status=$?
+
+cat "$cache/cached.out"
+
+front_end='^\(Parsing \|Converting$\|Using cached design$\)'
+
+if ! grep -v "$front_end" "$cache/uncached.out" > "$cache/uncached.cmp" ||
+   ! grep -v "$front_end" "$cache/cached.out" > "$cache/cached.cmp" ||
+   ! diff "$cache/uncached.cmp" "$cache/cached.cmp"
+then
+  echo "cached and uncached output differ"
+  status=1
+fi
+
+rm -rf "$cache"
+exit $status
@@ -0,0 +1,17 @@
+module main(input clk, input en);
+
+  reg [3:0] counter;
+  initial counter = 0;
+
+  // a modulo-10 counter
+  always @(posedge clk)
+    if(en)
+      counter <= counter == 9 ? 0 : counter + 1;
+
+  // neither is inductive
+  p0: assert property (counter != 12);
+  p1: assert property (counter != 13);
+
+  p2: assert property (counter != 7);
+
+endmodule
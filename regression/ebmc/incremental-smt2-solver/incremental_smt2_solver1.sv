@@ -0,0 +1,13 @@
+module main(input clk);
+
+  reg [7:0] counter;
+
+  initial counter = 0;
+
+  always @(posedge clk)
+    counter = counter + 1;
+
+  p0: assert property (counter != 5);
+  p1: assert property (counter != 20);
+
+endmodule
@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [7:0] counter;
+
+  initial counter = 0;
+
+  always @(posedge clk)
+    counter = counter + 1;
+
+  p0: assert property (counter != 3);
+  p1: assert property (counter != 20);
+  p2: assert property (counter != 4);
+  p3: assert property (counter != 30);
+  p4: assert property (counter != 5);
+
+endmodule
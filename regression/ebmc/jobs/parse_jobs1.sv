@@ -0,0 +1,10 @@
+module main(input clk);
+
+  wire [7:0] value;
+
+  counter c(clk, value);
+
+  p0: assert property (value != 3);
+  p1: assert property (value != 20);
+
+endmodule
@@ -0,0 +1,8 @@
+module counter(input clk, output reg [7:0] value);
+
+  initial value = 0;
+
+  always @(posedge clk)
+    value = value + 1;
+
+endmodule
@@ -0,0 +1,24 @@
+module main(input clk);
+
+  reg a, b, c;
+  reg [7:0] counter;
+
+  initial a = 0;
+  initial b = 0;
+  initial c = 0;
+  initial counter = 0;
+
+  always @(posedge clk) begin
+    a <= 0;
+    b <= a;
+    c <= b;
+    counter <= counter + 1;
+  end
+
+  // true, and 3-inductive
+  p0: assert property (c == 0);
+
+  // false, needs bound 4
+  p1: assert property (counter != 4);
+
+endmodule
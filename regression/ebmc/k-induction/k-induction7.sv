@@ -0,0 +1,16 @@
+module main(input clk, input i);
+
+  reg [1:0] s;
+
+  initial s = 0;
+
+  // State 1 is unreachable, and has a self-loop.
+  // State 2 is only reachable from state 1.
+  always @(posedge clk)
+    if(s == 1)
+      s <= i ? 2 : 1;
+
+  // not k-inductive for any k, but holds on simple paths of length 2
+  p0: assert property (s != 2);
+
+endmodule
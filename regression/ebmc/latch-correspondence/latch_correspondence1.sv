@@ -0,0 +1,20 @@
+module main(input clk, input [7:0] in);
+
+  reg [7:0] x, y;
+  reg flag;
+
+  initial x = 0;
+  initial y = 0;
+  initial flag = 0;
+
+  always @(posedge clk) begin
+    x = x + in;
+    y = in + y;
+    flag = flag & in[0];
+  end
+
+  // x and y are equal registers, and flag is always zero
+  p0: assert property (x == y && !flag);
+  p1: assert property (y != 10);
+
+endmodule
@@ -0,0 +1,17 @@
+module main(input clk, input [3:0] in);
+
+  reg [3:0] x, y;
+
+  initial x = 1;
+  initial y = 13;
+
+  always @(posedge clk) begin
+    x = x + in;
+    y = {in[3:2], x[1:0]};
+  end
+
+  // only the lower two bits of y are equal to those of x
+  p0: assert property (y[1:0] == x[1:0]);
+  p1: assert property (y != 13);
+
+endmodule
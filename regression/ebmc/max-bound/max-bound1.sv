@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [7:0] counter;
+
+  initial counter = 0;
+
+  always @(posedge clk)
+    counter = counter + 1;
+
+  // fails with bound 5
+  p0: assert property (counter != 5);
+
+  // holds up to bound 19
+  p1: assert property (counter != 20);
+
+endmodule
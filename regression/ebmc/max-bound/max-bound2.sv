@@ -0,0 +1,16 @@
+module main(input clk);
+
+  reg [7:0] counter;
+
+  initial counter = 0;
+
+  always @(posedge clk)
+    counter = counter + 1;
+
+  // fails in the initial state
+  p0: assert property (counter != 0);
+
+  // fails with bound 1
+  p1: assert property (counter != 1);
+
+endmodule
@@ -0,0 +1,15 @@
+module main(input clk);
+
+  reg [7:0] a, b;
+
+  initial a = 0;
+  initial b = 0;
+
+  always @(posedge clk) a = a + 1;
+
+  // not in the cone of influence of p1
+  always @(posedge clk) b = b + 2;
+
+  p1: assert property (a != 5);
+
+endmodule
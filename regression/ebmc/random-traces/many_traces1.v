@@ -0,0 +1,12 @@
+module main(input [7:0] input1);
+
+  wire clk;
+  reg [3:0] counter = 0;
+  reg [7:0] last_input = 0;
+
+  always @(posedge clk) begin
+    counter = counter + 1;
+    last_input = input1;
+  end
+
+endmodule
@@ -0,0 +1,6 @@
+module top;
+  sub instance1();
+endmodule
+
+module sub;
+endmodule
@@ -0,0 +1,17 @@
+#!/bin/sh
+
+# Runs vlindex twice with an index file in a fresh temporary
+# directory.  The first run writes the index, the second run
+# is the one whose output is checked.
+
+vlindex=$1
+shift
+
+dir=$(mktemp -d)
+
+"$vlindex" --index-file "$dir/index.vlindex" "$@" > /dev/null 2>&1
+"$vlindex" --index-file "$dir/index.vlindex" "$@"
+status=$?
+
+rm -rf "$dir"
+exit $status
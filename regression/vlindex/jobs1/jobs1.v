@@ -0,0 +1,4 @@
+module top;
+  sub1 instance1();
+  sub2 instance2();
+endmodule
@@ -0,0 +1,2 @@
+module sub1;
+endmodule
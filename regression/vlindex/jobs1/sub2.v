@@ -0,0 +1,3 @@
+module sub2;
+  sub1 instance3();
+endmodule
@@ -9,6 +9,15 @@ Author: Daniel Kroening, kroening@kroening.com
 #include "aiger_language.h"
 
 #include <util/message.h>
+#include <util/namespace.h>
+#include <util/std_expr.h>
+#include <util/symbol_table_base.h>
+
+#include <ebmc/ebmc_error.h>
+
+#include "aiger_parser.h"
+
+#include <ostream>
 
 /*******************************************************************\
 
@@ -23,11 +32,40 @@ Function: aiger_languaget::parse
 \*******************************************************************/
 
 bool aiger_languaget::parse(
-  std::istream &,
-  const std::string &,
-  message_handlert &)
+  std::istream &in,
+  const std::string &path,
+  message_handlert &message_handler)
 {
-  return true;
+  messaget message(message_handler);
+
+  netlist.clear();
+  netlist.var_map.clear();
+  netlist.initial.clear();
+  netlist.transition.clear();
+  netlist.properties.clear();
+  netlist.constraints.clear();
+
+  aiger_parsert aiger_parser(in, path, netlist, message_handler);
+
+  try
+  {
+    aiger_parser();
+  }
+  catch(const ebmc_errort &error)
+  {
+    message.error().source_location = error.location();
+    message.error() << error.what() << messaget::eom;
+    return true;
+  }
+
+  symbols = std::move(aiger_parser.symbols);
+
+  message.statistics() << "AIGER: " << netlist.var_map.inputs.size()
+                       << " inputs, " << netlist.var_map.latches.size()
+                       << " latches, " << netlist.number_of_nodes()
+                       << " nodes" << messaget::eom;
+
+  return false;
 }
 
 /*******************************************************************\
@@ -66,8 +104,8 @@ Function: aiger_languaget::dependencies
 \*******************************************************************/
 
 void aiger_languaget::dependencies(
-  const std::string &module,
-  std::set<std::string> &module_set)
+  const std::string &,
+  std::set<std::string> &)
 {
 }
 
@@ -86,6 +124,7 @@ Function: aiger_languaget::modules_provided
 void aiger_languaget::modules_provided(
   std::set<std::string> &module_set)
 {
+  module_set.insert(id2string(aiger_parsert::module_identifier));
 }
              
 /*******************************************************************\
@@ -101,11 +140,21 @@ Function: aiger_languaget::typecheck
 \*******************************************************************/
 
 bool aiger_languaget::typecheck(
-  symbol_table_baset &,
+  symbol_table_baset &symbol_table,
   const std::string &,
-  message_handlert &)
+  message_handlert &message_handler)
 {
-  return true;
+  for(const auto &symbol : symbols)
+  {
+    if(symbol_table.add(symbol))
+    {
+      messaget message(message_handler);
+      message.error() << "duplicate symbol " << symbol.name << messaget::eom;
+      return true;
+    }
+  }
+
+  return false;
 }
 
 /*******************************************************************\
@@ -137,8 +186,9 @@ Function: aiger_languaget::show_parse
 
 \*******************************************************************/
 
-void aiger_languaget::show_parse(std::ostream &, message_handlert &)
+void aiger_languaget::show_parse(std::ostream &out, message_handlert &)
 {
+  netlist.print(out);
 }
 
 /*******************************************************************\
@@ -158,7 +208,50 @@ bool aiger_languaget::from_expr(
   std::string &code,
   const namespacet &ns)
 {
-  return true;
+  if(expr.id() == ID_symbol)
+  {
+    const symbolt *symbol;
+    if(ns.lookup(to_symbol_expr(expr).get_identifier(), symbol))
+      code = id2string(to_symbol_expr(expr).get_identifier());
+    else
+      code = id2string(symbol->display_name());
+  }
+  else if(expr.is_true())
+    code = "1";
+  else if(expr.is_false())
+    code = "0";
+  else if(expr.id() == ID_not)
+  {
+    std::string op;
+    from_expr(to_not_expr(expr).op(), op, ns);
+    code = '!' + op;
+  }
+  else if(expr.id() == ID_and || expr.id() == ID_or)
+  {
+    code.clear();
+    for(auto &op : expr.operands())
+    {
+      std::string op_string;
+      from_expr(op, op_string, ns);
+      if(!code.empty())
+        code += expr.id() == ID_and ? " & " : " | ";
+      code += '(' + op_string + ')';
+    }
+  }
+  else if(
+    expr.id() == ID_sva_always || expr.id() == ID_G || expr.id() == ID_F)
+  {
+    std::string op;
+    from_expr(to_unary_expr(expr).op(), op, ns);
+    code = (expr.id() == ID_sva_always ? "always"
+            : expr.id() == ID_G        ? "G"
+                                       : "F") +
+           std::string(" ") + op;
+  }
+  else
+    return true;
+
+  return false;
 }
 
 /*******************************************************************\
@@ -176,9 +269,15 @@ Function: aiger_languaget::from_type
 bool aiger_languaget::from_type(
   const typet &type,
   std::string &code,
-  const namespacet &ns)
+  const namespacet &)
 {
-  return true;
+  if(type.id() == ID_bool)
+  {
+    code = "bool";
+    return false;
+  }
+  else
+    return true;
 }
 
 /*******************************************************************\
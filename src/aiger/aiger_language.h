@@ -10,8 +10,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #define CPROVER_AIGER_LANGUAGE_H
 
 #include <util/options.h>
+#include <util/symbol.h>
 
 #include <langapi/language.h>
+#include <trans-netlist/netlist.h>
 
 class aiger_languaget:public languaget
 {
@@ -74,12 +76,19 @@ public:
 
   std::set<std::string> extensions() const override
   { 
-    return { "aig" };
+    return {"aag", "aig"};
   }
 
   aiger_languaget()
   {
   }
+
+  // AIGER files are netlists already, and hence,
+  // we build the netlist while parsing
+  netlistt netlist;
+
+protected:
+  std::vector<symbolt> symbols;
 };
  
 std::unique_ptr<languaget> new_aiger_language();
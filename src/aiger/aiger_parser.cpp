@@ -0,0 +1,922 @@
+/*******************************************************************\
+
+Module: AIGER Parser
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "aiger_parser.h"
+
+#include <util/mathematical_expr.h>
+#include <util/std_expr.h>
+
+#include <ebmc/ebmc_error.h>
+#include <temporal-logic/temporal_expr.h>
+#include <verilog/sva_expr.h>
+
+#include <istream>
+
+const irep_idt aiger_parsert::module_identifier = "aiger::main";
+
+/*******************************************************************\
+
+Function: aiger_parsert::error
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::error(const std::string &message) const
+{
+  source_locationt location;
+  location.set_file(filename);
+  if(!binary)
+    location.set_line(static_cast<unsigned>(line_number));
+
+  throw ebmc_errort().with_location(location) << message;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::get
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+int aiger_parsert::get()
+{
+  int ch = in.get();
+  if(ch == '\n')
+    line_number++;
+  return ch;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::peek
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+int aiger_parsert::peek()
+{
+  return in.peek();
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::expect
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::expect(char expected)
+{
+  if(get() != expected)
+    error(std::string("expected '") + expected + "'");
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::expect_newline
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::expect_newline()
+{
+  if(peek() == '\r')
+    get();
+
+  if(get() != '\n')
+    error("expected new line");
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_number
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: reads an unsigned decimal number
+
+\*******************************************************************/
+
+std::size_t aiger_parsert::read_number()
+{
+  int ch = peek();
+
+  if(ch < '0' || ch > '9')
+    error("expected number");
+
+  std::size_t result = 0;
+
+  while(ch >= '0' && ch <= '9')
+  {
+    get();
+    result = result * 10 + (ch - '0');
+    ch = peek();
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_binary_number
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: reads an unsigned number in the 7-bit encoding
+          used for the AND gates of binary files
+
+\*******************************************************************/
+
+std::size_t aiger_parsert::read_binary_number()
+{
+  std::size_t result = 0;
+
+  for(unsigned shift = 0; shift < 64; shift += 7)
+  {
+    int ch = in.get();
+
+    if(ch == EOF)
+      error("unexpected end of file in AND gates");
+
+    result |= std::size_t(ch & 0x7f) << shift;
+
+    if((ch & 0x80) == 0)
+      return result;
+  }
+
+  error("invalid binary encoding of AND gate");
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_literal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::size_t aiger_parsert::read_literal()
+{
+  std::size_t l = read_number();
+
+  if((l >> 1) > max_var)
+    error("literal " + std::to_string(l) + " exceeds maximum variable index");
+
+  return l;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::define
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: record the definition of the variable of the given
+          (positive) literal
+
+\*******************************************************************/
+
+void aiger_parsert::define(std::size_t l, var_statet state)
+{
+  if((l & 1) != 0)
+    error("expected positive literal, but got " + std::to_string(l));
+
+  std::size_t var = l >> 1;
+
+  if(var == 0)
+    error("constant cannot be redefined");
+
+  if(var_state[var] != var_statet::UNDEFINED)
+    error("variable " + std::to_string(var) + " defined twice");
+
+  var_state[var] = state;
+
+  // inputs and latches become variable nodes of the netlist
+  if(state == var_statet::INPUT || state == var_statet::LATCH)
+    literals[var] = dest.new_var_node();
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::literal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the netlist literal for the given AIGER literal
+
+\*******************************************************************/
+
+literalt aiger_parsert::literal(std::size_t l) const
+{
+  std::size_t var = l >> 1;
+
+  switch(var_state[var])
+  {
+  case var_statet::INPUT:
+  case var_statet::LATCH:
+  case var_statet::DONE:
+    return literals[var] ^ ((l & 1) != 0);
+
+  case var_statet::UNDEFINED:
+  case var_statet::AND:
+  case var_statet::VISITING:
+  default:
+    error("literal " + std::to_string(l) + " is undefined");
+  }
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_header
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::read_header()
+{
+  std::string format;
+  for(std::size_t i = 0; i < 3; i++)
+    format += char(get());
+
+  if(format == "aag")
+    binary = false;
+  else if(format == "aig")
+    binary = true;
+  else
+    error("not an AIGER file");
+
+  std::vector<std::size_t> numbers;
+
+  while(peek() == ' ')
+  {
+    get();
+    numbers.push_back(read_number());
+  }
+
+  expect_newline();
+
+  // M I L O A, optionally followed by B C J F
+  if(numbers.size() < 5 || numbers.size() > 9)
+    error("invalid AIGER header");
+
+  numbers.resize(9, 0);
+
+  max_var = numbers[0];
+  no_inputs = numbers[1];
+  no_latches = numbers[2];
+  no_outputs = numbers[3];
+  no_ands = numbers[4];
+  no_bad = numbers[5];
+  no_constraints = numbers[6];
+  no_justice = numbers[7];
+  no_fairness = numbers[8];
+
+  if(binary && max_var != no_inputs + no_latches + no_ands)
+    error("binary AIGER header requires M = I + L + A");
+
+  if(no_inputs + no_latches + no_ands > max_var)
+    error("invalid AIGER header: I + L + A exceeds M");
+
+  literals.resize(max_var + 1, const_literal(false));
+  var_state.resize(max_var + 1, var_statet::UNDEFINED);
+  var_state[0] = var_statet::DONE;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_inputs
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::read_inputs()
+{
+  inputs.reserve(no_inputs);
+
+  for(std::size_t i = 0; i < no_inputs; i++)
+  {
+    std::size_t lhs;
+
+    if(binary)
+      lhs = 2 * (i + 1); // implicit
+    else
+    {
+      lhs = read_literal();
+      expect_newline();
+    }
+
+    define(lhs, var_statet::INPUT);
+    inputs.push_back(lhs);
+  }
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::read_latches()
+{
+  latches.reserve(no_latches);
+
+  for(std::size_t i = 0; i < no_latches; i++)
+  {
+    latcht latch;
+
+    if(binary)
+      latch.lhs = 2 * (no_inputs + i + 1); // implicit
+    else
+    {
+      latch.lhs = read_literal();
+      expect(' ');
+    }
+
+    latch.next = read_literal();
+
+    // AIGER 1.9: the reset value is 0, 1, or the latch itself,
+    // which means that the initial value is unconstrained
+    latch.reset = 0;
+
+    if(peek() == ' ')
+    {
+      get();
+      latch.reset = read_literal();
+
+      if(latch.reset != 0 && latch.reset != 1 && latch.reset != latch.lhs)
+        error("invalid reset value of latch " + std::to_string(latch.lhs));
+    }
+
+    expect_newline();
+
+    define(latch.lhs, var_statet::LATCH);
+    latches.push_back(latch);
+  }
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_literal_lines
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: outputs, bad states, constraints and fairness are
+          given as one literal per line
+
+\*******************************************************************/
+
+void aiger_parsert::read_literal_lines(
+  std::size_t count,
+  std::vector<std::size_t> &dest_literals)
+{
+  dest_literals.reserve(count);
+
+  for(std::size_t i = 0; i < count; i++)
+  {
+    dest_literals.push_back(read_literal());
+    expect_newline();
+  }
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_justice
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::read_justice()
+{
+  // first the sizes of all justice properties, then their literals
+  std::vector<std::size_t> sizes;
+  sizes.reserve(no_justice);
+
+  for(std::size_t i = 0; i < no_justice; i++)
+  {
+    sizes.push_back(read_number());
+    expect_newline();
+  }
+
+  justice.resize(no_justice);
+
+  for(std::size_t i = 0; i < no_justice; i++)
+    read_literal_lines(sizes[i], justice[i]);
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_and_gates
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::read_and_gates()
+{
+  if(binary)
+  {
+    // The gates are sorted topologically, and hence,
+    // can be added to the netlist as we go.
+    for(std::size_t i = 0; i < no_ands; i++)
+    {
+      std::size_t lhs = 2 * (no_inputs + no_latches + i + 1);
+
+      std::size_t delta0 = read_binary_number();
+      if(delta0 == 0 || delta0 > lhs)
+        error("invalid AND gate " + std::to_string(lhs));
+      std::size_t rhs0 = lhs - delta0;
+
+      std::size_t delta1 = read_binary_number();
+      if(delta1 > rhs0)
+        error("invalid AND gate " + std::to_string(lhs));
+      std::size_t rhs1 = rhs0 - delta1;
+
+      define(lhs, var_statet::AND);
+      literals[lhs >> 1] = aig_prop.land(literal(rhs0), literal(rhs1));
+      var_state[lhs >> 1] = var_statet::DONE;
+    }
+  }
+  else
+  {
+    // The gates of ASCII files can be given in any order.
+    and_gates.resize(max_var + 1);
+
+    for(std::size_t i = 0; i < no_ands; i++)
+    {
+      std::size_t lhs = read_literal();
+      expect(' ');
+      std::size_t rhs0 = read_literal();
+      expect(' ');
+      std::size_t rhs1 = read_literal();
+      expect_newline();
+
+      define(lhs, var_statet::AND);
+      and_gates[lhs >> 1] = {rhs0, rhs1};
+    }
+
+    resolve_and_gates();
+  }
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::resolve_and_gates
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: add the AND gates of an ASCII file to the netlist,
+          in depth-first order, using an explicit stack
+
+\*******************************************************************/
+
+void aiger_parsert::resolve_and_gates()
+{
+  std::vector<std::size_t> stack;
+
+  for(std::size_t var = 1; var <= max_var; var++)
+  {
+    if(var_state[var] != var_statet::AND)
+      continue;
+
+    stack.push_back(var);
+
+    while(!stack.empty())
+    {
+      std::size_t v = stack.back();
+      const auto &gate = and_gates[v];
+
+      if(var_state[v] == var_statet::AND)
+      {
+        var_state[v] = var_statet::VISITING;
+
+        for(auto operand : {gate.first, gate.second})
+        {
+          switch(var_state[operand >> 1])
+          {
+          case var_statet::AND:
+            stack.push_back(operand >> 1);
+            break;
+
+          case var_statet::VISITING:
+            error("cyclic definition of AND gate " + std::to_string(2 * v));
+
+          case var_statet::UNDEFINED:
+            error("literal " + std::to_string(operand) + " is undefined");
+
+          case var_statet::INPUT:
+          case var_statet::LATCH:
+          case var_statet::DONE:
+            break;
+          }
+        }
+      }
+      else
+      {
+        if(var_state[v] == var_statet::VISITING)
+        {
+          // the operands are done
+          literals[v] = aig_prop.land(literal(gate.first), literal(gate.second));
+          var_state[v] = var_statet::DONE;
+        }
+
+        stack.pop_back();
+      }
+    }
+  }
+
+  and_gates.clear();
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::read_symbol_table
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the optional symbol table and the optional comment section
+
+\*******************************************************************/
+
+void aiger_parsert::read_symbol_table()
+{
+  while(peek() != EOF)
+  {
+    char kind = char(get());
+
+    // "c" on a line of its own starts the comment section
+    if(kind == 'c' && (peek() == '\n' || peek() == '\r' || peek() == EOF))
+      return;
+
+    std::size_t count;
+
+    switch(kind)
+    {
+    case 'i': count = no_inputs; break;
+    case 'l': count = no_latches; break;
+    case 'o': count = no_outputs; break;
+    case 'b': count = no_bad; break;
+    case 'c': count = no_constraints; break;
+    case 'j': count = no_justice; break;
+    case 'f': count = no_fairness; break;
+    default:
+      error("invalid symbol table entry");
+    }
+
+    std::size_t index = read_number();
+
+    if(index >= count)
+      error(std::string("symbol table entry ") + kind + std::to_string(index) +
+            " out of range");
+
+    expect(' ');
+
+    std::string symbol_name;
+
+    while(peek() != '\n' && peek() != EOF)
+      symbol_name += char(get());
+
+    if(!symbol_name.empty() && symbol_name.back() == '\r')
+      symbol_name.pop_back();
+
+    if(peek() == '\n')
+      get();
+
+    names[{kind, index}] = symbol_name;
+  }
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::name
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the name from the symbol table, or the default name
+
+\*******************************************************************/
+
+std::string aiger_parsert::name(char kind, std::size_t index) const
+{
+  auto it = names.find({kind, index});
+
+  if(it != names.end() && !it->second.empty())
+    return it->second;
+  else
+    return kind + std::to_string(index);
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::add_variable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+irep_idt aiger_parsert::add_variable(
+  const std::string &base_name,
+  var_mapt::vart::vartypet vartype,
+  literalt l)
+{
+  const std::string prefix = id2string(module_identifier) + "::var::";
+
+  // the names in the symbol table are not necessarily unique
+  std::string unique_name = base_name;
+
+  for(std::size_t suffix = 1;
+      dest.var_map.map.find(prefix + unique_name) != dest.var_map.map.end();
+      suffix++)
+  {
+    unique_name = base_name + '#' + std::to_string(suffix);
+  }
+
+  irep_idt identifier = prefix + unique_name;
+
+  var_mapt::vart &var = dest.var_map.map[identifier];
+  var.vartype = vartype;
+  var.type = bool_typet();
+  var.mode = "AIGER";
+  var.add_bit().current = l;
+  var.bits.back().next = const_literal(false); // just to fill it
+
+  symbolt symbol{identifier, bool_typet(), "AIGER"};
+  symbol.base_name = unique_name;
+  symbol.pretty_name = unique_name;
+  symbol.module = module_identifier;
+  symbol.location.set_file(filename);
+  symbol.is_input = vartype == var_mapt::vart::vartypet::INPUT;
+  symbol.is_state_var = vartype == var_mapt::vart::vartypet::LATCH;
+  symbols.push_back(std::move(symbol));
+
+  return identifier;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::add_property
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+irep_idt aiger_parsert::add_property(
+  const std::string &base_name,
+  const exprt &expr,
+  const std::string &description)
+{
+  const std::string prefix = id2string(module_identifier) + "::spec::";
+
+  // the names of the bad states are not necessarily unique
+  std::string unique_name = base_name;
+
+  for(std::size_t suffix = 1;
+      property_identifiers.count(prefix + unique_name) != 0;
+      suffix++)
+  {
+    unique_name = base_name + '#' + std::to_string(suffix);
+  }
+
+  irep_idt identifier = prefix + unique_name;
+  property_identifiers.insert(identifier);
+
+  symbolt symbol{identifier, bool_typet(), "AIGER"};
+  symbol.base_name = unique_name;
+  symbol.pretty_name = unique_name;
+  symbol.module = module_identifier;
+  symbol.is_property = true;
+  symbol.value = expr;
+  symbol.location.set_file(filename);
+  symbol.location.set_comment(description);
+  symbols.push_back(std::move(symbol));
+
+  return identifier;
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::build_var_map
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::build_var_map()
+{
+  symbolt module_symbol{module_identifier, typet{ID_module}, "AIGER"};
+  module_symbol.base_name = "main";
+  module_symbol.pretty_name = "main";
+  module_symbol.module = module_identifier;
+  module_symbol.location.set_file(filename);
+
+  // The word-level transition relation is left empty;
+  // the netlist is the transition system.
+  module_symbol.value = transt{
+    ID_trans, true_exprt(), true_exprt(), true_exprt(), module_symbol.type};
+
+  symbols.push_back(std::move(module_symbol));
+
+  using vartypet = var_mapt::vart::vartypet;
+
+  for(std::size_t i = 0; i < inputs.size(); i++)
+    add_variable(name('i', i), vartypet::INPUT, literal(inputs[i]));
+
+  for(std::size_t i = 0; i < latches.size(); i++)
+  {
+    const auto &latch = latches[i];
+    literalt current = literal(latch.lhs);
+
+    auto identifier = add_variable(name('l', i), vartypet::LATCH, current);
+    dest.var_map.map[identifier].bits.front().next = literal(latch.next);
+
+    if(latch.reset == 0)
+      dest.initial.push_back(!current);
+    else if(latch.reset == 1)
+      dest.initial.push_back(current);
+    else
+    {
+      // uninitialized
+    }
+  }
+
+  // invariant constraints
+  for(auto c : constraints)
+    dest.constraints.push_back(literal(c));
+
+  // Without bad states and justice properties, the outputs
+  // are the bad states (AIGER 1.0, HWMCC'08).
+  const bool outputs_are_bad = bad.empty() && justice.empty();
+
+  if(!outputs_are_bad)
+  {
+    for(std::size_t i = 0; i < outputs.size(); i++)
+      add_variable(name('o', i), vartypet::WIRE, literal(outputs[i]));
+  }
+
+  const auto &bad_literals = outputs_are_bad ? outputs : bad;
+  const char bad_kind = outputs_are_bad ? 'o' : 'b';
+
+  for(std::size_t i = 0; i < bad_literals.size(); i++)
+  {
+    auto bad_name = name(bad_kind, i);
+    literalt l = literal(bad_literals[i]);
+    auto identifier = add_variable(bad_name, vartypet::WIRE, l);
+
+    auto property_identifier = add_property(
+      bad_name,
+      sva_always_exprt{not_exprt{symbol_exprt{identifier, bool_typet()}}},
+      "always !" + bad_name);
+
+    dest.properties.emplace(property_identifier, netlistt::Gpt{!l});
+  }
+
+  // A justice property fails if there is a path on which all of its
+  // literals and all fairness constraints hold infinitely often.
+  exprt::operandst fairness_operands;
+
+  for(std::size_t i = 0; i < fairness.size(); i++)
+  {
+    auto identifier =
+      add_variable(name('f', i), vartypet::WIRE, literal(fairness[i]));
+    fairness_operands.push_back(
+      G_exprt{F_exprt{symbol_exprt{identifier, bool_typet()}}});
+  }
+
+  for(std::size_t i = 0; i < justice.size(); i++)
+  {
+    auto justice_name = name('j', i);
+    exprt::operandst operands = fairness_operands;
+
+    for(std::size_t j = 0; j < justice[i].size(); j++)
+    {
+      auto identifier = add_variable(
+        justice_name + '.' + std::to_string(j),
+        vartypet::WIRE,
+        literal(justice[i][j]));
+      operands.push_back(
+        G_exprt{F_exprt{symbol_exprt{identifier, bool_typet()}}});
+    }
+
+    // These are not given to the netlist, as there is no
+    // netlist property for them.
+    add_property(
+      justice_name,
+      not_exprt{conjunction(operands)},
+      "justice " + justice_name);
+  }
+
+  dest.var_map.build_reverse_map();
+}
+
+/*******************************************************************\
+
+Function: aiger_parsert::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aiger_parsert::operator()()
+{
+  read_header();
+  read_inputs();
+  read_latches();
+  read_literal_lines(no_outputs, outputs);
+  read_literal_lines(no_bad, bad);
+  read_literal_lines(no_constraints, constraints);
+  read_justice();
+  read_literal_lines(no_fairness, fairness);
+  read_and_gates();
+  read_symbol_table();
+  build_var_map();
+}
@@ -0,0 +1,129 @@
+/*******************************************************************\
+
+Module: AIGER Parser
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// AIGER Parser
+
+#ifndef CPROVER_AIGER_PARSER_H
+#define CPROVER_AIGER_PARSER_H
+
+#include <util/symbol.h>
+
+#include <trans-netlist/aig_prop.h>
+#include <trans-netlist/netlist.h>
+
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/// Reads a file in the AIGER format, either ASCII ("aag") or binary
+/// ("aig"), including the AIGER 1.9 sections for bad states, invariant
+/// constraints, justice and fairness. The file is read as a stream,
+/// and the AND gates are added to the netlist as they are read,
+/// without any intermediate representation.
+/// The symbols for the inputs, latches and properties are collected
+/// in 'symbols', to be added to the symbol table by the type checker.
+class aiger_parsert
+{
+public:
+  aiger_parsert(
+    std::istream &_in,
+    const std::string &_filename,
+    netlistt &_dest,
+    message_handlert &message_handler)
+    : in(_in), filename(_filename), dest(_dest), aig_prop(_dest, message_handler)
+  {
+  }
+
+  /// throws ebmc_errort on malformed input
+  void operator()();
+
+  std::vector<symbolt> symbols;
+
+  static const irep_idt module_identifier;
+
+protected:
+  std::istream &in;
+  const std::string &filename;
+  netlistt &dest;
+  aig_prop_constraintt aig_prop;
+
+  std::size_t line_number = 1;
+  bool binary = false;
+
+  // the header: M I L O A B C J F
+  std::size_t max_var = 0, no_inputs = 0, no_latches = 0, no_outputs = 0,
+              no_ands = 0, no_bad = 0, no_constraints = 0, no_justice = 0,
+              no_fairness = 0;
+
+  // AIGER variable number to netlist literal
+  std::vector<literalt> literals;
+  enum class var_statet : char
+  {
+    UNDEFINED,
+    INPUT,
+    LATCH,
+    AND,
+    VISITING,
+    DONE
+  };
+  std::vector<var_statet> var_state;
+
+  // the AND gates of an ASCII file, which may be given in any order
+  std::vector<std::pair<std::size_t, std::size_t>> and_gates;
+
+  struct latcht
+  {
+    std::size_t lhs, next, reset;
+  };
+
+  std::vector<std::size_t> inputs;
+  std::vector<latcht> latches;
+  std::vector<std::size_t> outputs, bad, constraints, fairness;
+  std::vector<std::vector<std::size_t>> justice;
+
+  // names given in the symbol table section, by kind and position
+  std::map<std::pair<char, std::size_t>, std::string> names;
+
+  // the identifiers of the properties added so far
+  std::set<irep_idt> property_identifiers;
+
+  int get();
+  int peek();
+  void expect(char);
+  void expect_newline();
+  std::size_t read_number();
+  std::size_t read_binary_number();
+  std::size_t read_literal();
+  [[noreturn]] void error(const std::string &) const;
+
+  void read_header();
+  void read_inputs();
+  void read_latches();
+  void read_literal_lines(std::size_t, std::vector<std::size_t> &);
+  void read_justice();
+  void read_and_gates();
+  void read_symbol_table();
+
+  void define(std::size_t literal, var_statet);
+  void resolve_and_gates();
+  literalt literal(std::size_t) const;
+
+  void build_var_map();
+  std::string name(char kind, std::size_t index) const;
+  irep_idt
+  add_variable(const std::string &name, var_mapt::vart::vartypet, literalt);
+  irep_idt add_property(
+    const std::string &name,
+    const exprt &,
+    const std::string &description);
+};
+
+#endif // CPROVER_AIGER_PARSER_H
@@ -18,6 +18,7 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 #include <temporal-logic/temporal_logic.h>
 #include <trans-netlist/aig_prop.h>
 #include <trans-netlist/instantiate_netlist.h>
+#include <trans-netlist/netlist_coi.h>
 #include <trans-netlist/trans_to_netlist.h>
 #include <trans-netlist/trans_trace_netlist.h>
 #include <trans-netlist/unwind_netlist.h>
@@ -25,6 +26,7 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 
 #include <algorithm>
 #include <iostream>
+#include <set>
 
 /*******************************************************************\
 
@@ -39,7 +41,7 @@ class bdd_enginet
 public:
   bdd_enginet(
     const cmdlinet &_cmdline,
-    transition_systemt &_transition_system,
+    const transition_systemt &_transition_system,
     ebmc_propertiest &_properties,
     message_handlert &_message_handler)
     : cmdline(_cmdline),
@@ -56,7 +58,7 @@ protected:
   using propertiest = ebmc_propertiest;
   using propertyt = ebmc_propertiest::propertyt;
   const cmdlinet &cmdline;
-  transition_systemt &transition_system;
+  const transition_systemt &transition_system;
   propertiest &properties;
   messaget message;
   const namespacet ns;
@@ -79,6 +81,24 @@ protected:
   
   std::vector<BDD> constraints_BDDs, initial_BDDs,
                    transition_BDDs;
+
+  // The transition relation and the constraints, partitioned
+  // into clusters, which are conjoined one by one when computing
+  // the pre-image. The 'next' variables that no later cluster
+  // depends on are quantified as part of the conjunction.
+  struct clustert
+  {
+    BDD bdd;
+    std::set<unsigned> quantify;
+  };
+
+  std::vector<clustert> clusters;
+
+  // the 'next' variables that no cluster depends on
+  std::set<unsigned> quantify_first;
+
+  // the maximum number of nodes of a cluster
+  static constexpr std::size_t cluster_size_limit = 5000;
   
   class vart
   {
@@ -87,22 +107,19 @@ protected:
     BDD current, next;
   };
   
-  // this is our BDD variable ordering
-  class ordering
-  {
-  public:
-    bool operator()(const bv_varidt &a, const bv_varidt &b) const
-    {
-      if(a.bit_nr==b.bit_nr) return a.id<b.id;
-      return a.bit_nr<b.bit_nr;
-    }
-  };
-  
-  typedef std::map<bv_varidt, vart, ordering> varst;
+  typedef std::map<bv_varidt, vart> varst;
   varst vars;
-  
+
+  // this is our BDD variable ordering
+  std::vector<bv_varidt> variable_order;
+
+  // the maximum size of the BDD node table
+  std::size_t peak_bdd_nodes = 0;
+
   void allocate_vars(const var_mapt &);
+  void compute_variable_order();
   void build_BDDs();
+  void build_clusters();
   
   inline BDD aig2bdd(
     literalt l,
@@ -118,12 +135,21 @@ protected:
   }
 
   void get_atomic_propositions(const exprt &);
+  void reduce_to_coi();
   void check_property(propertyt &);
 
   BDD current_to_next(const BDD &) const;
   BDD next_to_current(const BDD &) const;
   BDD project_next(const BDD &) const;
   BDD project_current(const BDD &) const;
+  BDD pre_image(const BDD &);
+
+  using and_exists_cachet = std::map<std::pair<unsigned, unsigned>, BDD>;
+  BDD and_exists(
+    const BDD &,
+    const BDD &,
+    const std::set<unsigned> &,
+    and_exists_cachet &);
 
   void compute_counterexample(
     propertyt &,
@@ -191,9 +217,9 @@ property_checker_resultt bdd_enginet::operator()()
 
     message.status() << "Building netlist" << messaget::eom;
 
-    convert_trans_to_netlist(
-      transition_system.symbol_table,
-      transition_system.main_symbol->name,
+    convert_to_netlist(
+      cmdline,
+      transition_system,
       property_map,
       netlist,
       message.get_message_handler());
@@ -205,6 +231,9 @@ property_checker_resultt bdd_enginet::operator()()
     for(const auto &[_, expr] : property_map)
       get_atomic_propositions(expr);
 
+    if(!cmdline.isset("no-coi"))
+      reduce_to_coi();
+
     message.status() << "Building BDD for netlist" << messaget::eom;
 
     allocate_vars(netlist.var_map);
@@ -239,6 +268,9 @@ property_checker_resultt bdd_enginet::operator()()
     for(propertyt &p : properties.properties)
       check_property(p);
 
+    message.statistics() << "Peak BDD nodes: " << peak_bdd_nodes
+                         << messaget::eom;
+
     return property_checker_resultt{properties};
   }
   catch(const char *error_msg)
@@ -284,12 +316,113 @@ void bdd_enginet::allocate_vars(const var_mapt &var_map)
     }
   }
   
-  // now allocate BBD variables
-  for(auto &it : vars)
+  compute_variable_order();
+
+  // now allocate BBD variables, keeping the current and
+  // next-state variable of each bit adjacent
+  for(const auto &id : variable_order)
+  {
+    auto &var = vars[id];
+    std::string s = id.as_string();
+    var.current = mgr.Var(s);
+    var.next = mgr.Var(s + "'");
+  }
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::compute_variable_order
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Orders the variables by a depth-first traversal of the
+          fan-in of the atomic propositions and the constraints,
+          followed by the fan-in of the next-state functions of the
+          latches, in the order in which the latches are reached.
+          Variables that feed the same logic end up close together.
+
+\*******************************************************************/
+
+void bdd_enginet::compute_variable_order()
+{
+  std::vector<bool> visited(netlist.number_of_nodes(), false);
+  std::set<bv_varidt> ordered;
+
+  auto add_variable = [this, &ordered](const bv_varidt &id)
+  {
+    if(vars.find(id) != vars.end() && ordered.insert(id).second)
+      variable_order.push_back(id);
+  };
+
+  // post-order, with the explicit stack holding the nodes
+  // whose operands have been pushed
+  auto traverse = [this, &visited, &add_variable](literalt root)
+  {
+    if(root.is_constant())
+      return;
+
+    std::vector<std::pair<std::size_t, bool>> stack = {{root.var_no(), false}};
+
+    while(!stack.empty())
+    {
+      auto [n, expanded] = stack.back();
+      stack.pop_back();
+
+      if(visited[n])
+        continue;
+
+      const auto &node = netlist.nodes[n];
+
+      if(!node.is_and())
+      {
+        visited[n] = true;
+        add_variable(netlist.var_map.reverse(n));
+      }
+      else if(expanded)
+        visited[n] = true;
+      else
+      {
+        stack.emplace_back(n, true);
+        if(!node.b.is_constant())
+          stack.emplace_back(node.b.var_no(), false);
+        if(!node.a.is_constant())
+          stack.emplace_back(node.a.var_no(), false);
+      }
+    }
+  };
+
+  for(const auto &[_, a] : atomic_propositions)
+    traverse(a.l);
+
+  for(auto l : netlist.constraints)
+    traverse(l);
+
+  for(auto l : netlist.transition)
+    traverse(l);
+
+  // the next-state functions of the latches reached so far;
+  // these may reach further latches
+  std::size_t processed = 0;
+
+  auto traverse_next_state_functions = [&]()
+  {
+    for(; processed < variable_order.size(); processed++)
+    {
+      bv_varidt id = variable_order[processed];
+      if(!vars.at(id).is_input)
+        traverse(netlist.var_map.get_next(id));
+    }
+  };
+
+  traverse_next_state_functions();
+
+  // anything that is not reached from the properties
+  for(const auto &[id, _] : vars)
   {
-    std::string s=it.first.as_string();
-    it.second.current=mgr.Var(s);
-    it.second.next=mgr.Var(s+"'");
+    add_variable(id);
+    traverse_next_state_functions();
   }
 }
 
@@ -383,6 +516,255 @@ bdd_enginet::BDD bdd_enginet::project_current(const BDD &bdd) const
 
 /*******************************************************************\
 
+Function: bdd_support
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the variables a BDD depends on
+
+\*******************************************************************/
+
+static std::set<unsigned> bdd_support(const mini_bddt &bdd)
+{
+  std::set<unsigned> result, seen;
+  std::vector<mini_bddt> stack = {bdd};
+
+  while(!stack.empty())
+  {
+    mini_bddt b = stack.back();
+    stack.pop_back();
+
+    if(b.is_constant() || !seen.insert(b.node_number()).second)
+      continue;
+
+    result.insert(b.var());
+    stack.push_back(b.low());
+    stack.push_back(b.high());
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: bdd_size
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the number of inner nodes of a BDD
+
+\*******************************************************************/
+
+static std::size_t bdd_size(const mini_bddt &bdd)
+{
+  std::set<unsigned> seen;
+  std::vector<mini_bddt> stack = {bdd};
+
+  while(!stack.empty())
+  {
+    mini_bddt b = stack.back();
+    stack.pop_back();
+
+    if(b.is_constant() || !seen.insert(b.node_number()).second)
+      continue;
+
+    stack.push_back(b.low());
+    stack.push_back(b.high());
+  }
+
+  return seen.size();
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::and_exists
+
+  Inputs: two BDDs and a set of variables
+
+ Outputs: a BDD for the conjunction of the two BDDs,
+          with the given variables existentially quantified
+
+ Purpose: avoids building the conjunction before quantifying
+
+\*******************************************************************/
+
+bdd_enginet::BDD bdd_enginet::and_exists(
+  const BDD &f,
+  const BDD &g,
+  const std::set<unsigned> &quantify,
+  and_exists_cachet &cache)
+{
+  if(f.is_false() || g.is_false())
+    return mgr.False();
+
+  if(f.is_true() && g.is_true())
+    return mgr.True();
+
+  // conjunction is commutative
+  unsigned f_node = f.node_number(), g_node = g.node_number();
+  std::pair<unsigned, unsigned> key =
+    f_node < g_node ? std::make_pair(f_node, g_node)
+                    : std::make_pair(g_node, f_node);
+
+  auto cache_it = cache.find(key);
+  if(cache_it != cache.end())
+    return cache_it->second;
+
+  // the topmost variable of the two
+  unsigned var;
+
+  if(f.is_constant())
+    var = g.var();
+  else if(g.is_constant())
+    var = f.var();
+  else
+    var = std::min(f.var(), g.var());
+
+  bool f_split = !f.is_constant() && f.var() == var;
+  bool g_split = !g.is_constant() && g.var() == var;
+
+  const BDD &f_low = f_split ? f.low() : f;
+  const BDD &f_high = f_split ? f.high() : f;
+  const BDD &g_low = g_split ? g.low() : g;
+  const BDD &g_high = g_split ? g.high() : g;
+
+  BDD low = and_exists(f_low, g_low, quantify, cache);
+  BDD result;
+
+  if(quantify.find(var) != quantify.end())
+  {
+    if(low.is_true())
+      result = low;
+    else
+      result = low | and_exists(f_high, g_high, quantify, cache);
+  }
+  else
+  {
+    BDD high = and_exists(f_high, g_high, quantify, cache);
+    result = mgr.mk(var, low, high);
+  }
+
+  cache.emplace(key, result);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::pre_image
+
+  Inputs: a BDD for a set of states
+
+ Outputs: a BDD for the set of states that have a successor
+          in the given set
+
+ Purpose:
+
+\*******************************************************************/
+
+bdd_enginet::BDD bdd_enginet::pre_image(const BDD &states)
+{
+  // make the states be expressed in terms of 'next' variables
+  BDD result = current_to_next(states);
+
+  // now conjoin with the clusters of the transition relation,
+  // projecting away the 'next' variables as early as possible
+  if(clusters.empty())
+  {
+    and_exists_cachet cache;
+    return and_exists(result, mgr.True(), quantify_first, cache);
+  }
+
+  for(std::size_t i = 0; i < clusters.size(); i++)
+  {
+    const auto &cluster = clusters[i];
+    and_exists_cachet cache;
+
+    if(i == 0)
+    {
+      std::set<unsigned> quantify = quantify_first;
+      quantify.insert(cluster.quantify.begin(), cluster.quantify.end());
+      result = and_exists(result, cluster.bdd, quantify, cache);
+    }
+    else
+      result = and_exists(result, cluster.bdd, cluster.quantify, cache);
+
+    peak_bdd_nodes = std::max(peak_bdd_nodes, mgr.number_of_nodes());
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: bdd_enginet::build_clusters
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: partition the transition relation into clusters,
+          and compute the quantification schedule
+
+\*******************************************************************/
+
+void bdd_enginet::build_clusters()
+{
+  // The per-latch transition BDDs are in variable order.
+  // Merge neighbours as long as the clusters stay small.
+  std::vector<BDD> partitions = transition_BDDs;
+  partitions.insert(
+    partitions.end(), constraints_BDDs.begin(), constraints_BDDs.end());
+
+  for(const auto &partition : partitions)
+  {
+    if(partition.is_true())
+      continue;
+
+    if(!clusters.empty())
+    {
+      BDD merged = clusters.back().bdd & partition;
+
+      if(bdd_size(merged) <= cluster_size_limit)
+      {
+        clusters.back().bdd = merged;
+        continue;
+      }
+    }
+
+    clusters.push_back(clustert{partition, {}});
+  }
+
+  // A 'next' variable is quantified after the last cluster
+  // that depends on it.
+  std::set<unsigned> next_vars;
+
+  for(const auto &v : vars)
+    next_vars.insert(v.second.next.var());
+
+  for(auto cluster_it = clusters.rbegin(); cluster_it != clusters.rend();
+      cluster_it++)
+  {
+    for(auto var : bdd_support(cluster_it->bdd))
+    {
+      if(next_vars.erase(var) != 0)
+        cluster_it->quantify.insert(var);
+    }
+  }
+
+  quantify_first = std::move(next_vars);
+
+  message.statistics() << "Transition relation: " << partitions.size()
+                       << " partitions, " << clusters.size() << " clusters"
+                       << messaget::eom;
+}
+
+/*******************************************************************\
+
 Function: bdd_enginet::compute_counterexample
 
   Inputs:
@@ -401,6 +783,12 @@ void bdd_enginet::compute_counterexample(
   if(!netlist_bmc_supports_property(property.normalized_expr))
     return;
 
+  // find the netlist property, which a netlist given
+  // as AIGER file does not have for a property given with -p
+  auto netlist_property = netlist.properties.find(property.identifier);
+  if(netlist_property == netlist.properties.end())
+    return;
+
   message.status() << "Computing counterexample with " << number_of_timeframes
                    << " timeframe(s)" << messaget::eom;
 
@@ -409,10 +797,6 @@ void bdd_enginet::compute_counterexample(
 
   ::unwind(netlist, bmc_map, message, solver);
 
-  // find the netlist property
-  auto netlist_property = netlist.properties.find(property.identifier);
-  CHECK_RETURN(netlist_property != netlist.properties.end());
-
   ::unwind_property(
     netlist_property->second, bmc_map, property.timeframe_literals);
 
@@ -536,8 +920,6 @@ void bdd_enginet::check_AGp(propertyt &property)
   for(const auto &c : constraints_BDDs)
     states = states & c;
 
-  std::size_t peak_bdd_nodes = 0;
-
   while(true)
   {
     iteration++;
@@ -559,23 +941,8 @@ void bdd_enginet::check_AGp(propertyt &property)
       break;
     }
 
-    // make the states be expressed in terms of 'next' variables
-    BDD states_next = current_to_next(states);
-
-    // now conjoin with transition relation
-    BDD conjunction = states_next;
-
-    for(const auto &t : transition_BDDs)
-      conjunction = conjunction & t;
-
-    for(const auto &c : constraints_BDDs)
-      conjunction = conjunction & c;
-
-    // now project away 'next' variables
-    BDD pre_image = project_next(conjunction);
-
-    // compute union
-    BDD set_union = states | pre_image;
+    // compute union with the pre-image
+    BDD set_union = states | pre_image(states);
 
     // have we saturated?
     if((set_union == states).is_true())
@@ -752,22 +1119,7 @@ bdd_enginet::BDD bdd_enginet::EX(BDD f)
   for(const auto &c : constraints_BDDs)
     f = f & c;
 
-  // make 'f' be expressed in terms of 'next' variables
-  BDD p_next = current_to_next(f);
-
-  // now conjoin with transition relation
-  BDD conjunction = p_next;
-
-  for(const auto &t : transition_BDDs)
-    conjunction = conjunction & t;
-
-  for(const auto &c : constraints_BDDs)
-    conjunction = conjunction & c;
-
-  // now project away 'next' variables
-  BDD pre_image = project_next(conjunction);
-
-  return pre_image;
+  return pre_image(f);
 }
 
 /*******************************************************************\
@@ -927,6 +1279,53 @@ void bdd_enginet::get_atomic_propositions(const exprt &expr)
 
 /*******************************************************************\
 
+Function: bdd_enginet::reduce_to_coi
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: restrict the netlist to the nodes the atomic
+          propositions and the properties depend on
+
+\*******************************************************************/
+
+void bdd_enginet::reduce_to_coi()
+{
+  bvt roots;
+
+  for(const auto &[_, a] : atomic_propositions)
+    roots.push_back(a.l);
+
+  for(const auto &property : properties.properties)
+  {
+    if(property.is_disabled())
+      continue;
+
+    auto netlist_property = netlist.properties.find(property.identifier);
+
+    if(netlist_property != netlist.properties.end())
+    {
+      for(auto l : netlist_property_literals(netlist_property->second))
+        roots.push_back(l);
+    }
+  }
+
+  netlist_coit netlist_coi{netlist, roots};
+
+  for(auto &[_, a] : atomic_propositions)
+    a.l = netlist_coi.translate(a.l);
+
+  netlist = netlist_coi.netlist;
+
+  message.statistics() << "Cone of influence: latches: "
+                       << netlist.var_map.latches.size()
+                       << ", nodes: " << netlist.number_of_nodes()
+                       << messaget::eom;
+}
+
+/*******************************************************************\
+
 Function: bdd_enginet::build_BDDs
 
   Inputs:
@@ -965,12 +1364,16 @@ void bdd_enginet::build_BDDs()
   
   // Add the next-state variable constraints for
   // the state-holding elements.
-  for(const auto &v : vars)
-    if(!v.second.is_input)
+  // These are in variable order.
+  for(const auto &id : variable_order)
+  {
+    const auto &var = vars.at(id);
+    if(!var.is_input)
     {
-      literalt next=netlist.var_map.get_next(v.first);
-      transition_BDDs.push_back(aig2bdd(next, BDDs)==v.second.next);
+      literalt next=netlist.var_map.get_next(id);
+      transition_BDDs.push_back(aig2bdd(next, BDDs)==var.next);
     }
+  }
   
   // general AIG conditions
   for(literalt l : netlist.constraints)
@@ -1000,11 +1403,17 @@ void bdd_enginet::build_BDDs()
       {
         // find the netlist property
         auto netlist_property = netlist.properties.find(property.identifier);
-        CHECK_RETURN(netlist_property != netlist.properties.end());
+        if(netlist_property == netlist.properties.end())
+        {
+          property.failure("assumption not supported by BDD engine");
+          continue;
+        }
         auto l = std::get<netlistt::Gpt>(netlist_property->second).p;
         constraints_BDDs.push_back(aig2bdd(l, BDDs));
       }
     }
+
+  build_clusters();
 }
 
 /*******************************************************************\
@@ -1021,7 +1430,7 @@ Function: bdd_engine
 
 property_checker_resultt bdd_engine(
   const cmdlinet &cmdline,
-  transition_systemt &transition_system,
+  const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
@@ -13,7 +13,7 @@ Author: Daniel Kroening, kroening@kroening.com
 
 property_checker_resultt bdd_engine(
   const cmdlinet &,
-  transition_systemt &,
+  const transition_systemt &,
   ebmc_propertiest &,
   message_handlert &);
 
@@ -9,17 +9,110 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "bmc.h"
 
 #include <solvers/prop/literal_expr.h>
+#include <trans-word-level/lasso.h>
 #include <trans-word-level/trans_trace_word_level.h>
 #include <trans-word-level/unwind.h>
 
+#include "bmc_jobs.h"
 #include "ebmc_error.h"
 
 #include <chrono>
 #include <fstream>
+#include <optional>
+
+static void check_property(
+  ebmc_propertiest::propertyt &property,
+  decision_proceduret &solver,
+  std::size_t bound,
+  const namespacet &ns,
+  const transition_systemt &transition_system,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  message.status() << "Checking " << property.name << messaget::eom;
+
+  auto assumption = not_exprt{conjunction(property.timeframe_handles)};
+
+  decision_proceduret::resultt dec_result = solver(assumption);
+
+  switch(dec_result)
+  {
+  case decision_proceduret::resultt::D_SATISFIABLE:
+    if(property.is_exists_path())
+    {
+      property.proved();
+      message.result() << "SAT: path found" << messaget::eom;
+    }
+    else // universal path property
+    {
+      property.refuted();
+      message.result() << "SAT: counterexample found" << messaget::eom;
+    }
+
+    property.witness_trace = compute_trans_trace(
+      property.timeframe_handles,
+      solver,
+      bound + 1,
+      ns,
+      transition_system.main_symbol->name);
+    break;
+
+  case decision_proceduret::resultt::D_UNSATISFIABLE:
+    if(property.is_exists_path())
+    {
+      message.result() << "UNSAT: No path found within bound"
+                       << messaget::eom;
+      property.refuted_with_bound(bound);
+    }
+    else // universal path property
+    {
+      message.result() << "UNSAT: No counterexample found within bound"
+                       << messaget::eom;
+      property.proved_with_bound(bound);
+    }
+    break;
+
+  case decision_proceduret::resultt::D_ERROR:
+    message.error() << "Error from decision procedure" << messaget::eom;
+    property.failure();
+    break;
+
+  default:
+    property.failure();
+    throw ebmc_errort() << "Unexpected result from decision procedure";
+  }
+}
+
+static lasso_encodingt lasso_encoding(
+  lasso_encodingt encoding,
+  const ebmc_propertiest &properties,
+  messaget &message)
+{
+  // The linear encoding is only sound for the properties
+  // that are checked, not for the assumptions.
+  if(encoding == lasso_encodingt::LINEAR)
+  {
+    for(const auto &property : properties.properties)
+    {
+      if(property.is_assumed() && property.requires_lasso_constraints())
+      {
+        message.warning() << "using quadratic lasso encoding for "
+                          << "liveness assumption " << property.name
+                          << messaget::eom;
+        return lasso_encodingt::QUADRATIC;
+      }
+    }
+  }
+
+  return encoding;
+}
 
 void bmc(
   std::size_t bound,
   bool convert_only,
+  std::size_t jobs,
+  lasso_encodingt requested_lasso_encoding,
   const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   const ebmc_solver_factoryt &solver_factory,
@@ -71,7 +164,11 @@ void bmc(
   {
     message.status() << "Adding lasso constraints" << messaget::eom;
     lasso_constraints(
-      solver, bound + 1, ns, transition_system.main_symbol->name);
+      solver,
+      bound + 1,
+      ns,
+      transition_system.main_symbol->name,
+      lasso_encoding(requested_lasso_encoding, properties, message));
   }
 
   if(convert_only)
@@ -94,6 +191,7 @@ void bmc(
     auto sat_start_time = std::chrono::steady_clock::now();
 
     // Use assumptions to check the properties separately
+    std::vector<ebmc_propertiest::propertyt *> properties_to_check;
 
     for(auto &property : properties.properties)
     {
@@ -104,9 +202,134 @@ void bmc(
         continue;
       }
 
+      properties_to_check.push_back(&property);
+    }
+
+    check_properties_with_jobs(
+      jobs,
+      properties_to_check,
+      [&](ebmc_propertiest::propertyt &property, message_handlert &handler) {
+        check_property(
+          property, solver, bound, ns, transition_system, handler);
+      },
+      message_handler);
+
+    auto sat_stop_time = std::chrono::steady_clock::now();
+
+    message.statistics()
+      << "Solver time: "
+      << std::chrono::duration<double>(sat_stop_time - sat_start_time).count()
+      << messaget::eom;
+  }
+}
+
+void bmc_incremental(
+  std::size_t max_bound,
+  lasso_encodingt requested_lasso_encoding,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  const ebmc_solver_factoryt &solver_factory,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  const namespacet ns(transition_system.symbol_table);
+
+  // Is it supported by the BMC engine?
+  for(auto &property : properties.properties)
+  {
+    if(property.is_disabled() || property.is_failure())
+      continue;
+
+    if(!bmc_supports_property(property.normalized_expr))
+      property.failure("property not supported by BMC engine");
+  }
+
+  // We use one solver for all bounds, and only ever add the constraints
+  // for the new timeframe. The properties are checked using assumptions,
+  // and hence, nothing that depends on the bound is added permanently.
+  auto solver_wrapper = solver_factory(ns, message_handler);
+  auto &solver = solver_wrapper.decision_procedure();
+
+  const bool requires_lasso_constraints =
+    properties.requires_lasso_constraints();
+
+  const auto encoding =
+    lasso_encoding(requested_lasso_encoding, properties, message);
+
+  message.status() << "Solving with " << solver.decision_procedure_text()
+                   << messaget::eom;
+
+  auto sat_start_time = std::chrono::steady_clock::now();
+
+  // the largest bound for which the properties have been checked
+  std::optional<std::size_t> solved_bound;
+
+  unwind_cachet unwind_cache(transition_system.trans_expr);
+
+  for(std::size_t bound = 0; bound <= max_bound; bound++)
+  {
+    if(!properties.has_unknown_property())
+      break;
+
+    message.status() << "Doing BMC with bound " << bound << messaget::eom;
+
+    const std::size_t no_timeframes = bound + 1;
+
+    ::unwind_timeframe(
+      transition_system.trans_expr,
+      unwind_cache,
+      message_handler,
+      solver,
+      bound,
+      ns,
+      true);
+
+    if(requires_lasso_constraints)
+    {
+      lasso_constraints_timeframe(
+        solver, bound, ns, transition_system.main_symbol->name, encoding);
+    }
+
+    // The assumptions depend on the bound, and are passed
+    // to the solver together with the property.
+    exprt::operandst assumptions;
+
+    for(auto &property : properties.properties)
+    {
+      if(!property.is_assumed())
+        continue;
+
+      ::property(
+        property.normalized_expr,
+        property.timeframe_handles,
+        message_handler,
+        solver,
+        no_timeframes,
+        ns);
+
+      assumptions.push_back(conjunction(property.timeframe_handles));
+    }
+
+    for(auto &property : properties.properties)
+    {
+      // properties that have been decided are retired
+      if(!property.is_unknown())
+        continue;
+
+      ::property(
+        property.normalized_expr,
+        property.timeframe_handles,
+        message_handler,
+        solver,
+        no_timeframes,
+        ns);
+
       message.status() << "Checking " << property.name << messaget::eom;
 
-      auto assumption = not_exprt{conjunction(property.timeframe_handles)};
+      auto assumption = and_exprt{
+        conjunction(assumptions),
+        not_exprt{conjunction(property.timeframe_handles)}};
 
       decision_proceduret::resultt dec_result = solver(assumption);
 
@@ -127,24 +350,12 @@ void bmc(
         property.witness_trace = compute_trans_trace(
           property.timeframe_handles,
           solver,
-          bound + 1,
+          no_timeframes,
           ns,
           transition_system.main_symbol->name);
         break;
 
       case decision_proceduret::resultt::D_UNSATISFIABLE:
-        if(property.is_exists_path())
-        {
-          message.result() << "UNSAT: No path found within bound"
-                           << messaget::eom;
-          property.refuted_with_bound(bound);
-        }
-        else // universal path property
-        {
-          message.result() << "UNSAT: No counterexample found within bound"
-                           << messaget::eom;
-          property.proved_with_bound(bound);
-        }
         break;
 
       case decision_proceduret::resultt::D_ERROR:
@@ -158,11 +369,34 @@ void bmc(
       }
     }
 
-    auto sat_stop_time = std::chrono::steady_clock::now();
+    solved_bound = bound;
+  }
 
-    message.statistics()
-      << "Solver time: "
-      << std::chrono::duration<double>(sat_stop_time - sat_start_time).count()
-      << messaget::eom;
+  // The remaining properties hold up to the largest bound checked.
+  for(auto &property : properties.properties)
+  {
+    if(!property.is_unknown() || !solved_bound.has_value())
+      continue;
+
+    if(property.is_exists_path())
+    {
+      message.result() << property.name << ": no path found within bound"
+                       << messaget::eom;
+      property.refuted_with_bound(*solved_bound);
+    }
+    else // universal path property
+    {
+      message.result() << property.name
+                       << ": no counterexample found within bound"
+                       << messaget::eom;
+      property.proved_with_bound(*solved_bound);
+    }
   }
+
+  auto sat_stop_time = std::chrono::steady_clock::now();
+
+  message.statistics()
+    << "Solver time: "
+    << std::chrono::duration<double>(sat_stop_time - sat_start_time).count()
+    << messaget::eom;
 }
@@ -12,16 +12,33 @@ Author: Daniel Kroening, dkr@amazon.com
 #ifndef EBMC_BMC_H
 #define EBMC_BMC_H
 
+#include <trans-word-level/lasso.h>
+
 #include "ebmc_properties.h"
 #include "ebmc_solver_factory.h"
 
 class exprt;
 class transition_systemt;
 
-/// This is word-level BMC.
+/// This is word-level BMC. The properties are checked
+/// using \p jobs worker processes.
 void bmc(
   std::size_t bound,
   bool convert_only,
+  std::size_t jobs,
+  lasso_encodingt,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  const ebmc_solver_factoryt &,
+  message_handlert &);
+
+/// This is incremental word-level BMC. The bound is increased
+/// from 1 to the given maximum, using a single solver instance
+/// that is extended by one timeframe at a time. Properties are
+/// retired as soon as they are refuted.
+void bmc_incremental(
+  std::size_t max_bound,
+  lasso_encodingt,
   const transition_systemt &,
   ebmc_propertiest &,
   const ebmc_solver_factoryt &,
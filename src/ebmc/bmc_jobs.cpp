@@ -0,0 +1,271 @@
+/*******************************************************************\
+
+Module: Checking Properties with Multiple Jobs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "bmc_jobs.h"
+
+#include "ebmc_error.h"
+
+#include <algorithm>
+
+/*******************************************************************\
+
+Function: recording_message_handlert::to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+irept recording_message_handlert::to_irep() const
+{
+  irept result;
+
+  for(auto &message : messages)
+  {
+    irept irep{message.second};
+    irep.set_size_t(ID_message_level, message.first);
+    result.get_sub().push_back(std::move(irep));
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: recording_message_handlert::replay
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void recording_message_handlert::replay(
+  const irept &messages,
+  message_handlert &message_handler)
+{
+  for(auto &message : messages.get_sub())
+  {
+    auto level = static_cast<unsigned>(message.get_size_t(ID_message_level));
+    message_handler.print(level, message.id_string());
+  }
+}
+
+/*******************************************************************\
+
+Function: property_result_to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+irept property_result_to_irep(const ebmc_propertiest::propertyt &property)
+{
+  irept result;
+
+  result.set(ID_property_status, static_cast<int>(property.status));
+  result.set_size_t(ID_property_bound, property.bound);
+
+  if(property.failure_reason.has_value())
+    result.set(ID_property_failure_reason, property.failure_reason.value());
+
+  if(property.witness_trace.has_value())
+    result.add(ID_trans_trace) = to_irep(property.witness_trace->unpack());
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: property_result_from_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void property_result_from_irep(
+  const irept &result,
+  ebmc_propertiest::propertyt &property)
+{
+  property.status = static_cast<ebmc_propertiest::propertyt::statust>(
+    result.get_int(ID_property_status));
+  property.bound = result.get_size_t(ID_property_bound);
+
+  if(result.find(ID_property_failure_reason).is_not_nil())
+    property.failure_reason = result.get_string(ID_property_failure_reason);
+  else
+    property.failure_reason = {};
+
+  auto &trace = result.find(ID_trans_trace);
+  if(trace.is_not_nil())
+    property.witness_trace = trans_trace_from_irep(trace);
+  else
+    property.witness_trace = {};
+}
+
+/*******************************************************************\
+
+Function: worker_result
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static irept worker_result(
+  const ebmc_propertiest::propertyt &property,
+  const recording_message_handlert &message_handler)
+{
+  irept result = property_result_to_irep(property);
+  result.add(ID_property_messages) = message_handler.to_irep();
+  return result;
+}
+
+/*******************************************************************\
+
+Function: merge_worker_result
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void merge_worker_result(
+  const irept &result,
+  ebmc_propertiest::propertyt &property,
+  message_handlert &message_handler)
+{
+  recording_message_handlert::replay(
+    result.find(ID_property_messages), message_handler);
+
+  property_result_from_irep(result, property);
+}
+
+/*******************************************************************\
+
+Function: check_properties_with_jobs
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void check_properties_with_jobs(
+  std::size_t jobs,
+  const std::vector<ebmc_propertiest::propertyt *> &properties,
+  const std::function<void(ebmc_propertiest::propertyt &, message_handlert &)>
+    &check,
+  message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+#ifdef _WIN32
+  if(jobs > 1)
+    message.warning() << "multiple jobs are not supported on this platform"
+                      << messaget::eom;
+
+  jobs = 1;
+#endif
+
+  jobs = std::max(std::size_t(1), std::min(jobs, properties.size()));
+
+  if(jobs == 1)
+  {
+    for(auto property_ptr : properties)
+      check(*property_ptr, message_handler);
+
+    return;
+  }
+
+#ifndef _WIN32
+  message.status() << "Checking " << properties.size() << " properties with "
+                   << jobs << " jobs" << messaget::eom;
+
+  std::vector<ebmc_jobt> workers;
+
+  for(std::size_t index = 0; index < jobs; index++)
+  {
+    workers.push_back(fork_job(
+      [index, jobs, &properties, &check]()
+      {
+        irept results;
+
+        for(std::size_t i = index; i < properties.size(); i += jobs)
+        {
+          auto &property = *properties[i];
+          recording_message_handlert message_handler;
+
+          try
+          {
+            check(property, message_handler);
+          }
+          catch(const ebmc_errort &e)
+          {
+            property.failure(e.what());
+          }
+          catch(const char *e)
+          {
+            property.failure(e);
+          }
+          catch(const std::string &e)
+          {
+            property.failure(e);
+          }
+
+          results.get_sub().push_back(
+            worker_result(property, message_handler));
+        }
+
+        return results;
+      }));
+  }
+
+  std::vector<irept> results;
+  results.reserve(jobs);
+
+  for(auto &job : workers)
+    results.push_back(wait_job(job));
+
+  // merge, in the original order of the properties
+  for(std::size_t i = 0; i < properties.size(); i++)
+  {
+    auto &worker_results = results[i % jobs].get_sub();
+    std::size_t result_index = i / jobs;
+
+    if(result_index < worker_results.size())
+    {
+      merge_worker_result(
+        worker_results[result_index], *properties[i], message_handler);
+    }
+    else
+      properties[i]->failure("job did not complete");
+  }
+#endif
+}
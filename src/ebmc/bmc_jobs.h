@@ -0,0 +1,69 @@
+/*******************************************************************\
+
+Module: Checking Properties with Multiple Jobs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Checking Properties with Multiple Jobs
+
+#ifndef EBMC_BMC_JOBS_H
+#define EBMC_BMC_JOBS_H
+
+#include <util/message.h>
+
+#include <jobs/jobs.h>
+
+#include "ebmc_properties.h"
+
+#include <functional>
+#include <vector>
+
+/// Runs \p check on each of the given properties, using up to \p jobs
+/// worker processes. The workers are forked from the calling process,
+/// and hence, each starts with a copy of the formula that has been
+/// built so far, including the state of the solver. This does not
+/// work for solvers that talk to a separate solver process, as the
+/// workers would share the connection to it.
+/// The status, bound and trace of the properties are merged back
+/// into the caller's properties.
+/// The \p check function is given a message handler that is
+/// private to the worker, and should not output to the caller's.
+void check_properties_with_jobs(
+  std::size_t jobs,
+  const std::vector<ebmc_propertiest::propertyt *> &,
+  const std::function<void(ebmc_propertiest::propertyt &, message_handlert &)>
+    &check,
+  message_handlert &);
+
+/// Encodes the status, bound, failure reason and trace of a property.
+irept property_result_to_irep(const ebmc_propertiest::propertyt &);
+
+/// Inverse of property_result_to_irep
+void property_result_from_irep(const irept &, ebmc_propertiest::propertyt &);
+
+/// Records the messages of a job, to be replayed by the caller.
+class recording_message_handlert : public message_handlert
+{
+public:
+  void print(unsigned level, const std::string &message) override
+  {
+    messages.emplace_back(level, message);
+  }
+
+  void flush(unsigned) override
+  {
+  }
+
+  std::vector<std::pair<unsigned, std::string>> messages;
+
+  /// the recorded messages as irep, to send them to the caller
+  irept to_irep() const;
+
+  /// outputs the messages given by to_irep() to the given handler
+  static void replay(const irept &, message_handlert &);
+};
+
+#endif // EBMC_BMC_JOBS_H
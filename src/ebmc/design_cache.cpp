@@ -0,0 +1,322 @@
+/*******************************************************************\
+
+Module: Cache for Designs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "design_cache.h"
+
+#include <util/irep_serialization.h>
+#include <util/message.h>
+#include <util/unicode.h>
+
+#include "ebmc_version.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <unordered_set>
+
+#ifdef _WIN32
+#  include <process.h>
+#  define getpid _getpid
+#else
+#  include <unistd.h>
+#endif
+
+/*******************************************************************\
+
+Function: design_cachet::add_to_key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void design_cachet::add_to_key(const std::string &data)
+{
+  auto add_byte = [this](unsigned char byte)
+  {
+    hash ^= byte;
+    hash *= 0x100000001b3;
+  };
+
+  // the length first, to separate the parts of the key
+  for(std::size_t i = 0; i < sizeof(std::uint64_t); i++)
+    add_byte(static_cast<std::uint64_t>(data.size()) >> (i * 8));
+
+  for(auto ch : data)
+    add_byte(ch);
+}
+
+/*******************************************************************\
+
+Function: design_cachet::key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string design_cachet::key() const
+{
+  std::ostringstream result;
+  result << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return result.str();
+}
+
+/*******************************************************************\
+
+Function: design_cachet::file_name
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::string design_cachet::file_name() const
+{
+  return directory + "/" + key() + ".design";
+}
+
+/*******************************************************************\
+
+Function: symbol_to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static irept symbol_to_irep(const symbolt &symbol)
+{
+  irept result{symbol.name};
+
+  result.add(ID_type) = symbol.type;
+  result.add(ID_value) = symbol.value;
+  result.add(ID_location) = symbol.location;
+  result.set(ID_module, symbol.module);
+  result.set(ID_base_name, symbol.base_name);
+  result.set(ID_mode, symbol.mode);
+  result.set(ID_pretty_name, symbol.pretty_name);
+
+  result.set("is_type", symbol.is_type);
+  result.set("is_macro", symbol.is_macro);
+  result.set("is_exported", symbol.is_exported);
+  result.set("is_input", symbol.is_input);
+  result.set("is_output", symbol.is_output);
+  result.set("is_state_var", symbol.is_state_var);
+  result.set("is_property", symbol.is_property);
+  result.set("is_parameter", symbol.is_parameter);
+  result.set("is_auxiliary", symbol.is_auxiliary);
+  result.set("is_weak", symbol.is_weak);
+  result.set("is_lvalue", symbol.is_lvalue);
+  result.set("is_static_lifetime", symbol.is_static_lifetime);
+  result.set("is_thread_local", symbol.is_thread_local);
+  result.set("is_file_local", symbol.is_file_local);
+  result.set("is_extern", symbol.is_extern);
+  result.set("is_volatile", symbol.is_volatile);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: symbol_from_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static symbolt symbol_from_irep(const irept &src)
+{
+  symbolt symbol;
+
+  symbol.name = src.id();
+  symbol.type = static_cast<const typet &>(src.find(ID_type));
+  symbol.value = static_cast<const exprt &>(src.find(ID_value));
+  symbol.location =
+    static_cast<const source_locationt &>(src.find(ID_location));
+  symbol.module = src.get(ID_module);
+  symbol.base_name = src.get(ID_base_name);
+  symbol.mode = src.get(ID_mode);
+  symbol.pretty_name = src.get(ID_pretty_name);
+
+  symbol.is_type = src.get_bool("is_type");
+  symbol.is_macro = src.get_bool("is_macro");
+  symbol.is_exported = src.get_bool("is_exported");
+  symbol.is_input = src.get_bool("is_input");
+  symbol.is_output = src.get_bool("is_output");
+  symbol.is_state_var = src.get_bool("is_state_var");
+  symbol.is_property = src.get_bool("is_property");
+  symbol.is_parameter = src.get_bool("is_parameter");
+  symbol.is_auxiliary = src.get_bool("is_auxiliary");
+  symbol.is_weak = src.get_bool("is_weak");
+  symbol.is_lvalue = src.get_bool("is_lvalue");
+  symbol.is_static_lifetime = src.get_bool("is_static_lifetime");
+  symbol.is_thread_local = src.get_bool("is_thread_local");
+  symbol.is_file_local = src.get_bool("is_file_local");
+  symbol.is_extern = src.get_bool("is_extern");
+  symbol.is_volatile = src.get_bool("is_volatile");
+
+  return symbol;
+}
+
+/*******************************************************************\
+
+Function: design_cachet::read
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<symbol_tablet> design_cachet::read() const
+{
+  std::ifstream in(widen_if_needed(file_name()), std::ios::binary);
+
+  if(!in)
+    return {};
+
+  irept design;
+
+  try
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    design = irep_serializationt{ireps_container}.reference_convert(in);
+  }
+  catch(...)
+  {
+    return {};
+  }
+
+  // guard against files written by other versions,
+  // and against files for another key
+  if(
+    design.id() != "design" || design.get("version") != EBMC_VERSION ||
+    design.get("key") != key())
+  {
+    return {};
+  }
+
+  symbol_tablet symbol_table;
+
+  for(auto &symbol_irep : design.get_sub())
+    symbol_table.add(symbol_from_irep(symbol_irep));
+
+  return symbol_table;
+}
+
+/*******************************************************************\
+
+Function: design_cachet::write
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void design_cachet::write(
+  const symbol_tablet &symbol_table,
+  message_handlert &message_handler) const
+{
+  messaget message(message_handler);
+
+  irept design{"design"};
+  design.set("version", EBMC_VERSION);
+  design.set("key", key());
+
+  // The symbols are written in the order of the module map, which
+  // is the order in which they were added. The symbols of a module
+  // are enumerated in that order, e.g., for the list of properties
+  // and the variables in a trace; adding them in the same order
+  // on a cache hit gives the same output as the front end.
+  std::unordered_set<irep_idt> written;
+
+  for(auto &[_, identifier] : symbol_table.symbol_module_map)
+  {
+    if(written.insert(identifier).second)
+      design.get_sub().push_back(
+        symbol_to_irep(symbol_table.lookup_ref(identifier)));
+  }
+
+  // symbols that are not in the module map
+  for(auto &[identifier, symbol] : symbol_table.symbols)
+  {
+    if(written.find(identifier) == written.end())
+      design.get_sub().push_back(symbol_to_irep(symbol));
+  }
+
+  std::error_code error_code;
+  std::filesystem::create_directories(
+    widen_if_needed(directory), error_code);
+
+  if(error_code)
+  {
+    message.warning() << "failed to create design cache directory "
+                      << directory << messaget::eom;
+    return;
+  }
+
+  // Write to a temporary file first, such that a concurrent
+  // run never reads a partial design.
+  const auto final_file_name = file_name();
+  const auto tmp_file_name =
+    final_file_name + "." + std::to_string(getpid()) + ".tmp";
+
+  {
+    std::ofstream out(widen_if_needed(tmp_file_name), std::ios::binary);
+
+    if(out)
+    {
+      irep_serializationt::ireps_containert ireps_container;
+      irep_serializationt{ireps_container}.reference_convert(design, out);
+    }
+
+    if(!out)
+    {
+      out.close();
+      std::filesystem::remove(widen_if_needed(tmp_file_name), error_code);
+      message.warning() << "failed to write design cache file "
+                        << tmp_file_name << messaget::eom;
+      return;
+    }
+  }
+
+  std::filesystem::rename(
+    widen_if_needed(tmp_file_name),
+    widen_if_needed(final_file_name),
+    error_code);
+
+  if(error_code)
+  {
+    std::filesystem::remove(widen_if_needed(tmp_file_name), error_code);
+    message.warning() << "failed to write design cache file "
+                      << final_file_name << messaget::eom;
+  }
+}
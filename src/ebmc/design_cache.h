@@ -0,0 +1,57 @@
+/*******************************************************************\
+
+Module: Cache for Designs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Cache for Designs
+
+#ifndef EBMC_DESIGN_CACHE_H
+#define EBMC_DESIGN_CACHE_H
+
+#include <util/symbol_table.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+class message_handlert;
+
+/// Stores the symbol table produced by the front end in a directory,
+/// as binary irep. The entries are keyed by a hash of everything
+/// that the front end depends on, which the caller adds using
+/// add_to_key before reading or writing. The file records the full
+/// key, which is checked when reading.
+class design_cachet
+{
+public:
+  explicit design_cachet(std::string _directory)
+    : directory(std::move(_directory))
+  {
+  }
+
+  void add_to_key(const std::string &);
+
+  /// the symbol table with the key, if cached
+  std::optional<symbol_tablet> read() const;
+
+  /// stores the symbol table with the key; a cache that cannot
+  /// be written only gives a warning
+  void write(const symbol_tablet &, message_handlert &) const;
+
+protected:
+  std::string directory;
+
+  // FNV-1a
+  std::uint64_t hash = 0xcbf29ce484222325;
+
+  /// the hash as hex string
+  std::string key() const;
+
+  std::string file_name() const;
+};
+
+#endif // EBMC_DESIGN_CACHE_H
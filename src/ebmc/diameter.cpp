@@ -8,8 +8,6 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <assert.h>
 
-#include <iostream>
-
 #include "diameter.h"
 
 /*******************************************************************\
@@ -431,7 +429,6 @@ void sort_states(propt &solver, const std::vector<bvt> &states, std::vector<bvt>
 
   compare_counter=0;
   bitonicSort(solver, sorted_states, 0, sorted_states.size(), ASCENDING);
-  std::cout << "compare_counter: " << compare_counter << '\n';
 }
 
 /*******************************************************************\
@@ -149,9 +149,9 @@ bool ebmc_baset::make_netlist(netlistt &netlist)
 
   try
   {
-    convert_trans_to_netlist(
-      transition_system.symbol_table,
-      transition_system.main_symbol->name,
+    convert_to_netlist(
+      cmdline,
+      transition_system,
       properties.make_property_map(),
       netlist,
       message.get_message_handler());
@@ -351,6 +351,9 @@ void ebmc_parse_optionst::help()
     "\n"
     "Additonal options:\n"
     " {y--bound} {unr}               \t set bound (default: 1)\n"
+    " {y--max-bound} {unr}           \t incremental BMC with bounds 1 to nr\n"
+    " {y--jobs} {unr}                \t parse the files and check the properties\n"
+    "                                \t using nr jobs\n"
     " {y--module} {umodule}          \t set top module (deprecated)\n"
     " {y--top} {umodule}             \t set top module\n"
     " {y-p} {uexpr}                  \t specify a property\n"
@@ -363,13 +366,22 @@ void ebmc_parse_optionst::help()
     " {y--show-properties}           \t list the properties in the model\n"
     " {y--property} {uid}            \t check the property with given ID\n"
     " {y-I} {upath}                  \t set include path\n"
+    " {y--design-cache} {udirectory} \t keep the type-checked design in the given\n"
+    "                                \t directory, for reuse by later runs\n"
     " {y--systemverilog}             \t force SystemVerilog instead of Verilog\n"
     " {y--reset} {uexpr}             \t set up module reset\n"
     " {y--liveness-to-safety}        \t translate liveness properties to safety properties\n"
+    " {y--no-coi}                    \t do not reduce netlists to the cone of influence\n"
+    " {y--aig-opt}                   \t optimize netlists by rewriting, balancing and SAT sweeping\n"
+    " {y--latch-correspondence}      \t merge latches that are equivalent or constant in all reachable states\n"
+    " {y--linear-lasso}              \t use a lasso encoding for liveness BMC that is linear in the bound\n"
     "\n"
     "Methods:\n"
-    " {y--k-induction}               \t do k-induction with k=bound\n"
+    " {y--k-induction}               \t do k-induction with k=bound, or with k=1 to nr\n"
+    "                                \t given --max-bound nr\n"
+    " {y--simple-path}               \t k-induction: add simple-path constraints when needed\n"
     " {y--bdd}                       \t use (unbounded) BDD engine\n"
+    " {y--portfolio}                 \t run BMC, k-induction, BDDs and IC3 concurrently\n"
     " {y--ic3}                       \t use IC3 engine with options described below\n"
     "    {y--constr}                 \t use constraints specified in 'file.cnstr'\n"
     "    {y--new-mode}               \t new mode is switched on\n"
@@ -403,6 +415,8 @@ void ebmc_parse_optionst::help()
     " {y--mathsat}                   \t use MathSAT as solver\n"
     " {y--yices}                     \t use Yices as solver\n"
     " {y--z3}                        \t use Z3 as solver\n"
+    " {y--incremental-smt2-solver} {ucmd}\n"
+    "                                \t use {ucmd} as interactive SMT2 solver\n"
     "\n"
     "Debugging options:\n"
     " {y--preprocess}                \t output the preprocessed source file\n"
@@ -23,7 +23,8 @@ public:
   ebmc_parse_optionst(int argc, const char **argv)
     : parse_options_baset(
         "(diameter)(ediameter)"
-        "(diatest)(statebits):(bound):(max-bound):"
+        "(diatest)(statebits):(bound):(max-bound):(jobs):"
+        "(design-cache):"
         "(show-parse)(show-varmap)(show-symbol-table)(show-netlist)"
         "(show-ldg)(show-modules)(show-module-hierarchy)"
         "(show-trans)(show-bdds)(show-formula)"
@@ -31,7 +32,8 @@ public:
         "(modules-xml):"
         "(show-properties)(property):p:(trace)(waveform)(numbered-trace)"
         "(dimacs)(module):(top):"
-        "(po)(cegar)(k-induction)(2pi)(bound2):"
+        "(po)(cegar)(k-induction)(simple-path)(2pi)(bound2):(portfolio)"
+        "(linear-lasso)"
         "(outfile):(xml-ui)(verbosity):(gui)"
         "(json-modules):(json-properties):(json-result):"
         "(neural-liveness)(neural-engine):"
@@ -42,7 +44,8 @@ public:
         "(interpolation-word)(interpolator):(bdd)"
         "(ranking-function):"
         "(smt2)(bitwuzla)(boolector)(cvc3)(cvc4)(cvc5)(mathsat)(yices)(z3)"
-        "(aig)(stop-induction)(stop-minimize)(start):(coverage)(naive)"
+        "(incremental-smt2-solver):"
+        "(aig)(aig-opt)(latch-correspondence)(no-coi)(stop-induction)(stop-minimize)(start):(coverage)(naive)"
         "(compute-ct)(dot-netlist)(smv-netlist)(vcd):"
         "(random-traces)(trace-steps):(random-seed):(traces):"
         "(random-trace)(random-waveform)"
@@ -14,7 +14,7 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <solvers/prop/literal.h>
 #include <temporal-logic/temporal_logic.h>
-#include <trans-netlist/trans_trace.h>
+#include <trans-netlist/packed_trans_trace.h>
 #include <trans-word-level/property.h>
 
 #include "transition_system.h"
@@ -50,7 +50,7 @@ public:
     } status = statust::UNKNOWN;
 
     std::size_t bound = 0;
-    std::optional<trans_tracet> witness_trace;
+    std::optional<packed_trans_tracet> witness_trace;
     std::optional<std::string> failure_reason;
 
     bool has_witness_trace() const
@@ -14,6 +14,8 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <solvers/prop/prop.h>
 #include <solvers/sat/satcheck.h>
 #include <solvers/smt2/smt2_dec.h>
+#include <solvers/smt2_incremental/smt2_incremental_decision_procedure.h>
+#include <solvers/smt2_incremental/smt_solver_process.h>
 
 #include "ebmc_error.h"
 #include "ebmc_version.h"
@@ -56,6 +58,29 @@ ebmc_solver_factoryt ebmc_solver_factory(const cmdlinet &cmdline)
     }
   }
 
+  if(cmdline.isset("incremental-smt2-solver"))
+  {
+    // Keeps one solver process alive for the lifetime of the decision
+    // procedure, and talks to it over a pipe. Assertions are sent as they
+    // are added, and assumptions are passed using check-sat-assuming.
+    const std::string solver_command =
+      cmdline.get_value("incremental-smt2-solver");
+
+    return [solver_command](
+             const namespacet &ns, message_handlert &message_handler)
+    {
+      messaget message(message_handler);
+      message.status() << "Using incremental SMT2 solver `" << solver_command
+                       << "'" << messaget::eom;
+
+      auto solver_process = std::make_unique<smt_piped_solver_processt>(
+        solver_command, message_handler, nullptr);
+
+      return ebmc_solvert{std::make_unique<smt2_incremental_decision_proceduret>(
+        ns, std::move(solver_process), message_handler)};
+    };
+  }
+
   std::optional<smt2_convt::solvert> smt2_solver =
     cmdline.isset("bitwuzla")    ? smt2_convt::solvert::BITWUZLA
     : cmdline.isset("boolector") ? smt2_convt::solvert::BOOLECTOR
@@ -9,5 +9,16 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include <util/cmdline.h>
 #include <util/ui_message.h>
 
+#include "ebmc_properties.h"
+
 int do_ic3(const cmdlinet &, ui_message_handlert &);
 
+/// Checks the properties of the given transition system using IC3,
+/// one after the other, and updates their status.
+/// IC3 outputs to stdout.
+void ic3_check_properties(
+  const cmdlinet &,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
@@ -18,9 +18,10 @@ Author: Daniel Kroening, daniel.kroening@inf.ethz.ch
 #include "bmc.h"
 #include "ebmc_error.h"
 #include "ebmc_solver_factory.h"
-#include "liveness_to_safety.h"
+#include "simple_path.h"
 
 #include <fstream>
+#include <map>
 
 /*******************************************************************\
 
@@ -35,11 +36,13 @@ class k_inductiont
 public:
   k_inductiont(
     std::size_t _k,
+    bool _simple_path,
     const transition_systemt &_transition_system,
     ebmc_propertiest &_properties,
     const ebmc_solver_factoryt &_solver_factory,
     message_handlert &_message_handler)
     : k(_k),
+      simple_path(_simple_path),
       transition_system(_transition_system),
       properties(_properties),
       solver_factory(_solver_factory),
@@ -49,6 +52,10 @@ public:
 
   void operator()();
 
+  /// Increases k from 1 up to the given k, until all
+  /// properties are decided.
+  void incremental();
+
   static bool
   have_supported_property(const ebmc_propertiest::propertiest &properties)
   {
@@ -60,6 +67,7 @@ public:
 
 protected:
   const std::size_t k;
+  const bool simple_path;
   const transition_systemt &transition_system;
   ebmc_propertiest &properties;
   const ebmc_solver_factoryt &solver_factory;
@@ -96,13 +104,49 @@ Function: k_induction
 
 void k_induction(
   std::size_t k,
+  bool simple_path,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  const ebmc_solver_factoryt &solver_factory,
+  message_handlert &message_handler)
+{
+  k_inductiont(
+    k,
+    simple_path,
+    transition_system,
+    properties,
+    solver_factory,
+    message_handler)();
+}
+
+/*******************************************************************\
+
+Function: k_induction_incremental
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void k_induction_incremental(
+  std::size_t max_k,
+  bool simple_path,
   const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   const ebmc_solver_factoryt &solver_factory,
   message_handlert &message_handler)
 {
   k_inductiont(
-    k, transition_system, properties, solver_factory, message_handler)();
+    max_k,
+    simple_path,
+    transition_system,
+    properties,
+    solver_factory,
+    message_handler)
+    .incremental();
 }
 
 /*******************************************************************\
@@ -119,12 +163,14 @@ Function: k_induction
 
 property_checker_resultt k_induction(
   const cmdlinet &cmdline,
-  transition_systemt &transition_system,
+  const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
   std::size_t k = [&cmdline, &message_handler]() -> std::size_t {
-    if(!cmdline.isset("bound"))
+    if(cmdline.isset("max-bound"))
+      return unsafe_string2size_t(cmdline.get_value("max-bound"));
+    else if(!cmdline.isset("bound"))
     {
       messaget message(message_handler);
       message.warning() << "using 1-induction" << messaget::eom;
@@ -137,10 +183,6 @@ property_checker_resultt k_induction(
   if(properties.properties.empty())
     throw ebmc_errort() << "no properties";
 
-  // liveness to safety translation, if requested
-  if(cmdline.isset("liveness-to-safety"))
-    liveness_to_safety(transition_system, properties);
-
   // Are there any properties suitable for k-induction?
   // Fail early if not.
   if(!k_inductiont::have_supported_property(properties.properties))
@@ -150,8 +192,28 @@ property_checker_resultt k_induction(
 
   auto solver_factory = ebmc_solver_factory(cmdline);
 
-  k_induction(
-    k, transition_system, properties, solver_factory, message_handler);
+  const bool simple_path = cmdline.isset("simple-path");
+
+  if(cmdline.isset("max-bound"))
+  {
+    k_induction_incremental(
+      k,
+      simple_path,
+      transition_system,
+      properties,
+      solver_factory,
+      message_handler);
+  }
+  else
+  {
+    k_induction(
+      k,
+      simple_path,
+      transition_system,
+      properties,
+      solver_factory,
+      message_handler);
+  }
 
   return property_checker_resultt{properties};
 }
@@ -203,6 +265,8 @@ void k_inductiont::induction_base()
   bmc(
     k,
     false,
+    1,
+    lasso_encodingt::QUADRATIC,
     transition_system,
     properties,
     solver_factory,
@@ -284,6 +348,22 @@ void k_inductiont::induction_step()
 
     decision_proceduret::resultt dec_result = solver();
 
+    // Add the simple-path constraints only when the
+    // counterexample to induction visits a state twice.
+    if(
+      simple_path && dec_result == decision_proceduret::resultt::D_SATISFIABLE)
+    {
+      simple_path_constraintst simple_path_constraints{
+        solver_wrapper, ns, transition_system.main_symbol->name};
+
+      if(simple_path_constraints.has_repeated_state(no_timeframes - 1))
+      {
+        message.status() << "Adding simple-path constraints" << messaget::eom;
+        simple_path_constraints.add(no_timeframes - 1);
+        dec_result = solver();
+      }
+    }
+
     switch(dec_result)
     {
     case decision_proceduret::resultt::D_SATISFIABLE:
@@ -307,3 +387,190 @@ void k_inductiont::induction_step()
     }
   }
 }
+
+/*******************************************************************\
+
+Function: k_inductiont::incremental
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void k_inductiont::incremental()
+{
+  // Fail unsupported properties
+  for(auto &property : properties.properties)
+  {
+    if(!supported(property))
+      property.failure("property unsupported by k-induction");
+  }
+
+  const namespacet ns(transition_system.symbol_table);
+  const auto &trans_expr = transition_system.trans_expr;
+  auto &message_handler = message.get_message_handler();
+
+  // One solver for the base case, which starts in an initial state,
+  // and one for the step case, which doesn't. Both are extended by
+  // one timeframe per round, and the properties are checked using
+  // assumptions, so nothing that depends on k is added permanently.
+  auto base_solver_wrapper = solver_factory(ns, message_handler);
+  auto &base_solver = base_solver_wrapper.decision_procedure();
+  auto step_solver_wrapper = solver_factory(ns, message_handler);
+  auto &step_solver = step_solver_wrapper.decision_procedure();
+
+  message.status() << "Solving with " << base_solver.decision_procedure_text()
+                   << messaget::eom;
+
+  // The handles for the properties in each timeframe, for each solver.
+  struct handlest
+  {
+    exprt::operandst base, step;
+  };
+
+  std::map<irep_idt, handlest> handles;
+
+  // The properties that have been proved are invariants, and are
+  // added to the step case for all timeframes, as are the assumptions.
+  auto is_invariant = [](const ebmc_propertiest::propertyt &property)
+  { return property.is_assumed() || property.is_proved(); };
+
+  // both solvers share the instances of the transition relation
+  unwind_cachet unwind_cache(trans_expr);
+
+  auto add_timeframe = [&](std::size_t t)
+  {
+    ::unwind_timeframe(
+      trans_expr, unwind_cache, message_handler, base_solver, t, ns, true);
+    ::unwind_timeframe(
+      trans_expr, unwind_cache, message_handler, step_solver, t, ns, false);
+
+    for(auto &property : properties.properties)
+    {
+      if(!property.is_unknown() && !is_invariant(property))
+        continue;
+
+      const exprt &p = to_unary_expr(property.normalized_expr).op();
+      exprt instance = instantiate(p, t, t + 1);
+
+      if(property.is_assumed())
+      {
+        base_solver.set_to_true(instance);
+        step_solver.set_to_true(instance);
+      }
+      else
+      {
+        auto &property_handles = handles[property.identifier];
+        property_handles.base.push_back(base_solver.handle(instance));
+        property_handles.step.push_back(step_solver.handle(instance));
+
+        if(is_invariant(property))
+          step_solver.set_to_true(property_handles.step.back());
+      }
+    }
+  };
+
+  add_timeframe(0);
+
+  simple_path_constraintst simple_path_constraints{
+    step_solver_wrapper, ns, transition_system.main_symbol->name};
+
+  // the timeframes the simple-path constraints have been added for
+  std::size_t simple_path_k = 0;
+
+  for(std::size_t current_k = 1; current_k <= k; current_k++)
+  {
+    if(!properties.has_unknown_property())
+      break;
+
+    message.status() << "k-induction with k=" << current_k << messaget::eom;
+
+    const std::size_t no_timeframes = current_k + 1;
+
+    add_timeframe(current_k);
+
+    for(auto &property : properties.properties)
+    {
+      // properties that have been decided are retired
+      if(!property.is_unknown())
+        continue;
+
+      message.status() << "Checking " << property.name << messaget::eom;
+
+      // Induction base: the property fails in one of the new
+      // timeframes. The earlier timeframes have been checked
+      // in the previous rounds.
+      const auto &base_handles = handles[property.identifier].base;
+      exprt::operandst new_timeframes(
+        base_handles.begin() + (current_k == 1 ? 0 : current_k),
+        base_handles.end());
+
+      auto base_result = base_solver(not_exprt{conjunction(new_timeframes)});
+
+      if(base_result == decision_proceduret::resultt::D_SATISFIABLE)
+      {
+        message.result() << "SAT: counterexample found" << messaget::eom;
+        property.refuted();
+        property.witness_trace = compute_trans_trace(
+          base_handles,
+          base_solver,
+          no_timeframes,
+          ns,
+          transition_system.main_symbol->name);
+        continue;
+      }
+      else if(base_result != decision_proceduret::resultt::D_UNSATISFIABLE)
+        throw ebmc_errort() << "Error from decision procedure";
+
+      // Induction step: the property holds in timeframes 0,...,k-1,
+      // but not in timeframe k.
+      const auto &step_handles = handles[property.identifier].step;
+      exprt::operandst step_assumption(
+        step_handles.begin(), step_handles.end() - 1);
+      step_assumption.push_back(not_exprt{step_handles.back()});
+
+      auto step_result = step_solver(conjunction(step_assumption));
+
+      // Add the simple-path constraints only when the
+      // counterexample to induction visits a state twice.
+      if(
+        simple_path && simple_path_k < current_k &&
+        step_result == decision_proceduret::resultt::D_SATISFIABLE &&
+        simple_path_constraints.has_repeated_state(current_k))
+      {
+        message.status() << "Adding simple-path constraints for k="
+                         << current_k << messaget::eom;
+        simple_path_constraints.add(current_k);
+        simple_path_k = current_k;
+        step_result = step_solver(conjunction(step_assumption));
+      }
+
+      if(step_result == decision_proceduret::resultt::D_UNSATISFIABLE)
+      {
+        message.result() << "UNSAT: inductive proof successful with k="
+                         << current_k << ", property holds" << messaget::eom;
+        property.proved();
+
+        // from now on, the property is an invariant of the step case
+        for(auto &handle : step_handles)
+          step_solver.set_to_true(handle);
+      }
+      else if(step_result != decision_proceduret::resultt::D_SATISFIABLE)
+        throw ebmc_errort() << "Error from decision procedure";
+    }
+  }
+
+  // The remaining properties hold up to k, but are not k-inductive.
+  for(auto &property : properties.properties)
+  {
+    if(property.is_unknown())
+    {
+      message.result() << property.name << ": no inductive proof with k up to "
+                       << k << messaget::eom;
+      property.inconclusive();
+    }
+  }
+}
@@ -20,13 +20,25 @@ class ebmc_propertiest;
 
 property_checker_resultt k_induction(
   const cmdlinet &,
-  transition_systemt &,
+  const transition_systemt &,
   ebmc_propertiest &,
   message_handlert &);
 
 // Basic k-induction. The result is stored in the ebmc_propertiest argument.
+// The simple-path constraints are added to the step case when needed.
 void k_induction(
   std::size_t k,
+  bool simple_path,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  const ebmc_solver_factoryt &,
+  message_handlert &);
+
+// k-induction with k=1,...,max_k, extending the base and step case
+// by one timeframe per round.
+void k_induction_incremental(
+  std::size_t max_k,
+  bool simple_path,
   const transition_systemt &,
   ebmc_propertiest &,
   const ebmc_solver_factoryt &,
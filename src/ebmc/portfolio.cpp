@@ -0,0 +1,319 @@
+/*******************************************************************\
+
+Module: Portfolio of Engines
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "portfolio.h"
+
+#include "bdd_engine.h"
+#include "bmc_jobs.h"
+#include "ebmc_error.h"
+#include "ic3_engine.h"
+#include "k_induction.h"
+
+#include <algorithm>
+
+#ifndef _WIN32
+#  include <fcntl.h>
+#  include <poll.h>
+#  include <unistd.h>
+#endif
+
+/*******************************************************************\
+
+Function: status_rank
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: how much we know about the property, given the status
+
+\*******************************************************************/
+
+static int status_rank(ebmc_propertiest::propertyt::statust status)
+{
+  using statust = ebmc_propertiest::propertyt::statust;
+
+  switch(status)
+  {
+  case statust::PROVED:
+  case statust::REFUTED:
+    return 4;
+  case statust::PROVED_WITH_BOUND:
+  case statust::REFUTED_WITH_BOUND:
+    return 3;
+  case statust::INCONCLUSIVE:
+    return 2;
+  case statust::DROPPED:
+  case statust::FAILURE:
+    return 1;
+  case statust::UNKNOWN:
+  case statust::DISABLED:
+  case statust::ASSUMED:
+    return 0;
+  }
+
+  UNREACHABLE;
+}
+
+/*******************************************************************\
+
+Function: is_decided
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static bool is_decided(const ebmc_propertiest::propertyt &property)
+{
+  return property.is_disabled() || property.is_assumed() ||
+         property.is_proved() || property.is_refuted();
+}
+
+#ifndef _WIN32
+
+/*******************************************************************\
+
+Function: ic3_engine
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: runs IC3 on all properties; the engine runs in a job
+          of its own
+
+\*******************************************************************/
+
+static property_checker_resultt ic3_engine(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  // IC3 writes to stdout
+  int null_fd = open("/dev/null", O_WRONLY);
+  if(null_fd != -1)
+  {
+    dup2(null_fd, STDOUT_FILENO);
+    close(null_fd);
+  }
+
+  ic3_check_properties(
+    cmdline, transition_system, properties, message_handler);
+
+  return property_checker_resultt{properties};
+}
+
+#endif
+
+/*******************************************************************\
+
+Function: portfolio
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+property_checker_resultt portfolio(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+#ifdef _WIN32
+  throw ebmc_errort() << "portfolio is not supported on this platform";
+#else
+  if(properties.properties.empty())
+    throw ebmc_errort() << "no properties";
+
+  messaget message(message_handler);
+
+  using enginet = std::function<property_checker_resultt(
+    const transition_systemt &, ebmc_propertiest &, message_handlert &)>;
+
+  std::vector<std::pair<std::string, enginet>> engines = {
+    {"BMC",
+     [&cmdline](
+       const transition_systemt &transition_system,
+       ebmc_propertiest &properties,
+       message_handlert &message_handler) {
+       // netlists have no word-level transition relation
+       if(transition_system.netlist.has_value())
+         return bit_level_bmc(
+           cmdline, transition_system, properties, message_handler);
+       else
+         return word_level_bmc(
+           cmdline, transition_system, properties, message_handler);
+     }},
+    {"k-induction",
+     [&cmdline](
+       const transition_systemt &transition_system,
+       ebmc_propertiest &properties,
+       message_handlert &message_handler) {
+       return k_induction(
+         cmdline, transition_system, properties, message_handler);
+     }},
+    {"BDD",
+     [&cmdline](
+       const transition_systemt &transition_system,
+       ebmc_propertiest &properties,
+       message_handlert &message_handler) {
+       return bdd_engine(
+         cmdline, transition_system, properties, message_handler);
+     }},
+    {"IC3",
+     [&cmdline](
+       const transition_systemt &transition_system,
+       ebmc_propertiest &properties,
+       message_handlert &message_handler) {
+       return ic3_engine(
+         cmdline, transition_system, properties, message_handler);
+     }}};
+
+  // k-induction requires the word-level transition relation
+  if(transition_system.netlist.has_value())
+  {
+    engines.erase(
+      std::remove_if(
+        engines.begin(),
+        engines.end(),
+        [](const std::pair<std::string, enginet> &engine)
+        { return engine.first == "k-induction"; }),
+      engines.end());
+  }
+
+  // Each engine runs in its own process, on a copy of the
+  // transition system and the properties.
+  std::vector<ebmc_jobt> jobs;
+
+  for(auto &engine : engines)
+  {
+    message.status() << "Starting " << engine.first << messaget::eom;
+
+    jobs.push_back(fork_job(
+      [&engine, &transition_system, &properties]()
+      {
+        null_message_handlert null_message_handler;
+
+        auto result =
+          engine.second(transition_system, properties, null_message_handler);
+
+        irept results;
+
+        if(
+          result.status ==
+          property_checker_resultt::statust::VERIFICATION_RESULT)
+        {
+          for(auto &property : result.properties)
+            results.get_sub().push_back(property_result_to_irep(property));
+        }
+
+        return results;
+      }));
+  }
+
+  std::vector<bool> running(jobs.size(), true);
+  std::size_t number_running = jobs.size();
+
+  while(number_running != 0)
+  {
+    std::vector<pollfd> pollfds;
+    std::vector<std::size_t> job_indices;
+
+    for(std::size_t i = 0; i < jobs.size(); i++)
+      if(running[i])
+      {
+        pollfds.push_back(pollfd{jobs[i].fd, POLLIN, 0});
+        job_indices.push_back(i);
+      }
+
+    if(poll(pollfds.data(), pollfds.size(), -1) == -1)
+      throw ebmc_errort() << "failed to wait for engines";
+
+    for(std::size_t j = 0; j < pollfds.size(); j++)
+    {
+      if(pollfds[j].revents == 0)
+        continue;
+
+      auto i = job_indices[j];
+      auto &engine_name = engines[i].first;
+      auto result = wait_job(jobs[i]);
+      running[i] = false;
+      number_running--;
+
+      if(result.is_nil())
+      {
+        message.status() << engine_name << " did not complete"
+                         << messaget::eom;
+        continue;
+      }
+
+      message.status() << engine_name << " has finished" << messaget::eom;
+
+      // the engine has worked on a copy of our properties
+      auto &property_results = result.get_sub();
+      std::size_t index = 0;
+
+      for(auto &property : properties.properties)
+      {
+        if(index >= property_results.size())
+          break;
+
+        auto &property_result = property_results[index++];
+
+        if(property.is_disabled() || property.is_assumed())
+          continue;
+
+        ebmc_propertiest::propertyt candidate = property;
+        property_result_from_irep(property_result, candidate);
+
+        if(status_rank(candidate.status) > status_rank(property.status))
+        {
+          property = std::move(candidate);
+
+          if(is_decided(property))
+          {
+            message.status() << engine_name << ": " << property.name << " "
+                             << property.status_as_string() << messaget::eom;
+          }
+        }
+      }
+    }
+
+    // Terminate the remaining engines once all properties are decided.
+    bool all_decided = true;
+
+    for(auto &property : properties.properties)
+      if(!is_decided(property))
+        all_decided = false;
+
+    if(all_decided)
+    {
+      for(std::size_t i = 0; i < jobs.size(); i++)
+        if(running[i])
+        {
+          message.status() << "Terminating " << engines[i].first
+                           << messaget::eom;
+          kill_job(jobs[i]);
+          running[i] = false;
+          number_running--;
+        }
+    }
+  }
+
+  return property_checker_resultt{properties};
+#endif
+}
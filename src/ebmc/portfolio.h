@@ -0,0 +1,28 @@
+/*******************************************************************\
+
+Module: Portfolio of Engines
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Portfolio of Engines
+
+#ifndef EBMC_PORTFOLIO_H
+#define EBMC_PORTFOLIO_H
+
+#include "property_checker.h"
+
+/// Runs word-level BMC, k-induction, the BDD engine and IC3
+/// concurrently on the given transition system. A property is
+/// decided by the first engine that proves or refutes it,
+/// and the remaining engines are terminated once all properties
+/// have been decided.
+property_checker_resultt portfolio(
+  const cmdlinet &,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+#endif // EBMC_PORTFOLIO_H
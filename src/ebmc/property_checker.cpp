@@ -11,6 +11,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/string2int.h>
 
 #include <solvers/sat/satcheck.h>
+#include <trans-netlist/netlist_coi.h>
 #include <trans-netlist/trans_to_netlist.h>
 #include <trans-netlist/trans_trace_netlist.h>
 #include <trans-netlist/unwind_netlist.h>
@@ -22,6 +23,7 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "ebmc_solver_factory.h"
 #include "k_induction.h"
 #include "output_file.h"
+#include "portfolio.h"
 #include "report_results.h"
 
 #include <chrono>
@@ -38,6 +40,10 @@ property_checker_resultt word_level_bmc(
   bool convert_only = cmdline.isset("smt2") || cmdline.isset("outfile") ||
                       cmdline.isset("show-formula");
 
+  auto lasso_encoding = cmdline.isset("linear-lasso")
+                          ? lasso_encodingt::LINEAR
+                          : lasso_encodingt::QUADRATIC;
+
   try
   {
     if(cmdline.isset("max-bound"))
@@ -48,18 +54,16 @@ property_checker_resultt word_level_bmc(
       const std::size_t max_bound =
         unsafe_string2size_t(cmdline.get_value("max-bound"));
 
-      for(std::size_t bound = 1; bound <= max_bound; bound++)
-      {
-        messaget message{message_handler};
-        message.status() << "Doing BMC with bound " << bound << messaget::eom;
-
-#if 0
-        const namespacet ns(transition_system.symbol_table);
-        CHECK_RETURN(trans_expr.has_value());
-        ::unwind(*trans_expr, *message_handler, solver, bound+1, ns, true);
-        result=finish_word_level_bmc(solver);
-#endif
-      }
+      if(properties.properties.empty())
+        throw "no properties";
+
+      bmc_incremental(
+        max_bound,
+        lasso_encoding,
+        transition_system,
+        properties,
+        solver_factory,
+        message_handler);
     }
     else
     {
@@ -76,6 +80,20 @@ property_checker_resultt word_level_bmc(
         bound = 1;
       }
 
+      std::size_t jobs = cmdline.isset("jobs")
+                           ? unsafe_string2size_t(cmdline.get_value("jobs"))
+                           : 1;
+
+      // The workers are forked after the solver has been set up, and
+      // would share the pipe to a solver process.
+      if(jobs > 1 && cmdline.isset("incremental-smt2-solver"))
+      {
+        messaget message{message_handler};
+        message.warning() << "--jobs is ignored with --incremental-smt2-solver"
+                          << messaget::eom;
+        jobs = 1;
+      }
+
       if(!convert_only)
         if(properties.properties.empty())
           throw "no properties";
@@ -83,6 +101,8 @@ property_checker_resultt word_level_bmc(
       bmc(
         bound,
         convert_only,
+        jobs,
+        lasso_encoding,
         transition_system,
         properties,
         solver_factory,
@@ -193,7 +213,7 @@ property_checker_resultt bit_level_bmc(
   cnft &solver,
   bool convert_only,
   const cmdlinet &cmdline,
-  transition_systemt &transition_system,
+  const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
@@ -221,9 +241,9 @@ property_checker_resultt bit_level_bmc(
     netlistt netlist;
     message.status() << "Generating Netlist" << messaget::eom;
 
-    convert_trans_to_netlist(
-      transition_system.symbol_table,
-      transition_system.main_symbol->name,
+    convert_to_netlist(
+      cmdline,
+      transition_system,
       properties.make_property_map(),
       netlist,
       message.get_message_handler());
@@ -232,6 +252,33 @@ property_checker_resultt bit_level_bmc(
                          << ", nodes: " << netlist.number_of_nodes()
                          << messaget::eom;
 
+    if(!cmdline.isset("no-coi"))
+    {
+      // only unwind what the properties depend on
+      bvt roots;
+
+      for(auto &property : properties.properties)
+      {
+        if(property.is_disabled())
+          continue;
+
+        auto netlist_property = netlist.properties.find(property.identifier);
+
+        if(netlist_property != netlist.properties.end())
+        {
+          for(auto l : netlist_property_literals(netlist_property->second))
+            roots.push_back(l);
+        }
+      }
+
+      netlist = netlist_coit{netlist, roots}.netlist;
+
+      message.statistics() << "Cone of influence: latches: "
+                           << netlist.var_map.latches.size()
+                           << ", nodes: " << netlist.number_of_nodes()
+                           << messaget::eom;
+    }
+
     messaget message{message_handler};
     message.status() << "Unwinding Netlist" << messaget::eom;
 
@@ -253,9 +300,15 @@ property_checker_resultt bit_level_bmc(
         continue;
       }
 
-      // look up the property in the netlist
+      // look up the property in the netlist; a netlist given as
+      // AIGER file only has its own properties, not those given with -p
       auto netlist_property = netlist.properties.find(property.identifier);
-      CHECK_RETURN(netlist_property != netlist.properties.end());
+
+      if(netlist_property == netlist.properties.end())
+      {
+        property.failure("property not supported by netlist BMC engine");
+        continue;
+      }
 
       ::unwind_property(
         netlist_property->second, bmc_map, property.timeframe_literals);
@@ -305,7 +358,7 @@ property_checker_resultt bit_level_bmc(
 
 property_checker_resultt bit_level_bmc(
   const cmdlinet &cmdline,
-  transition_systemt &transition_system,
+  const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
@@ -360,19 +413,30 @@ property_checker_resultt bit_level_bmc(
 
 property_checker_resultt property_checker(
   const cmdlinet &cmdline,
-  transition_systemt &transition_system,
+  const transition_systemt &transition_system,
   ebmc_propertiest &properties,
   message_handlert &message_handler)
 {
   auto result = [&]() -> property_checker_resultt
   {
-    if(cmdline.isset("bdd") || cmdline.isset("show-bdds"))
+    if(cmdline.isset("portfolio"))
+    {
+      return portfolio(cmdline, transition_system, properties, message_handler);
+    }
+    else if(cmdline.isset("bdd") || cmdline.isset("show-bdds"))
     {
       return bdd_engine(
         cmdline, transition_system, properties, message_handler);
     }
-    else if(cmdline.isset("aig") || cmdline.isset("dimacs"))
+    else if(
+      cmdline.isset("aig") || cmdline.isset("dimacs") ||
+      transition_system.netlist.has_value())
     {
+      // Netlists (AIGER) have no word-level transition relation,
+      // and hence, use netlist BMC by default.
+      if(transition_system.netlist.has_value() && cmdline.isset("k-induction"))
+        throw ebmc_errort() << "k-induction is not supported for netlists";
+
       return bit_level_bmc(
         cmdline, transition_system, properties, message_handler);
     }
@@ -73,9 +73,23 @@ public:
   int exit_code() const;
 };
 
+/// word-level BMC, with the bound given on the command line
+property_checker_resultt word_level_bmc(
+  const cmdlinet &,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
+/// netlist BMC, with the bound given on the command line
+property_checker_resultt bit_level_bmc(
+  const cmdlinet &,
+  const transition_systemt &,
+  ebmc_propertiest &,
+  message_handlert &);
+
 property_checker_resultt property_checker(
   const cmdlinet &,
-  transition_systemt &,
+  const transition_systemt &,
   ebmc_propertiest &,
   message_handlert &);
 
@@ -14,8 +14,12 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/expr_util.h>
 #include <util/find_symbols.h>
 #include <util/string2int.h>
+#include <util/symbol_table.h>
 #include <util/unicode.h>
 
+#include <trans-netlist/netlist_simulator.h>
+#include <trans-netlist/trans_to_netlist.h>
+#include <trans-netlist/trans_trace_netlist.h>
 #include <trans-word-level/instantiate_word_level.h>
 #include <trans-word-level/trans_trace_word_level.h>
 #include <trans-word-level/unwind.h>
@@ -27,7 +31,81 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <algorithm>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <random>
+#include <set>
+#include <unordered_set>
+
+/*******************************************************************\
+
+   Class: trans_trace_collectort
+
+ Purpose: collects the states, and passes the trace to a consumer
+
+\*******************************************************************/
+
+class trans_trace_collectort : public trans_trace_sinkt
+{
+public:
+  trans_trace_collectort(
+    std::string mode,
+    const std::function<void(trans_tracet)> &_consumer)
+    : consumer(_consumer)
+  {
+    trace.mode = std::move(mode);
+  }
+
+  void state(const trans_tracet::statet &state) override
+  {
+    trace.states.push_back(state);
+  }
+
+  void finish() override
+  {
+    consumer(std::move(trace));
+  }
+
+protected:
+  const std::function<void(trans_tracet)> &consumer;
+  trans_tracet trace;
+};
+
+/*******************************************************************\
+
+   Class: vcd_file_sinkt
+
+ Purpose: writes a trace into a VCD file as the states arrive
+
+\*******************************************************************/
+
+class vcd_file_sinkt : public trans_trace_sinkt
+{
+public:
+  vcd_file_sinkt(const namespacet &ns, const std::string &filename)
+    : outfile(filename), vcd_sink(ns, outfile.stream())
+  {
+  }
+
+  void state(const trans_tracet::statet &state) override
+  {
+    vcd_sink.state(state);
+  }
+
+  void finish() override
+  {
+    vcd_sink.finish();
+  }
+
+  const std::string &name()
+  {
+    return outfile.name();
+  }
+
+protected:
+  output_filet outfile;
+  vcd_trace_sinkt vcd_sink;
+};
 
 /*******************************************************************\
 
@@ -57,6 +135,17 @@ public:
     std::size_t number_of_traces,
     std::size_t number_of_trace_steps);
 
+  // gives a sink for the trace with the given number
+  using sink_factoryt =
+    std::function<std::unique_ptr<trans_trace_sinkt>(std::size_t trace_nr)>;
+
+  // the states are passed to the sinks as they are produced
+  void operator()(
+    const sink_factoryt &,
+    std::size_t random_seed,
+    std::size_t number_of_traces,
+    std::size_t number_of_trace_steps);
+
 protected:
   const transition_systemt &transition_system;
   const ebmc_solver_factoryt &solver_factory;
@@ -93,6 +182,17 @@ protected:
     std::size_t number_of_timeframes,
     decision_proceduret &) const;
 
+  // Bit-parallel simulation of the netlist, which does not require
+  // a solver. Free variable nodes, e.g., undriven wires, are given
+  // random values as well. Returns false if the design is not
+  // deterministic given the random values, e.g., owing to constraints.
+  bool simulate(
+    const sink_factoryt &,
+    const symbolst &inputs,
+    const symbolst &unconstrained_state_variables,
+    std::size_t number_of_traces,
+    std::size_t number_of_timeframes);
+
   // Random number generator. These are fully specified in
   // the C++ standard, and produce the same values on compliant
   // implementations.
@@ -177,20 +277,31 @@ int random_traces(const cmdlinet &cmdline, message_handlert &message_handler)
   if(cmdline.isset("waveform") && cmdline.isset("vcd"))
     throw ebmc_errort() << "cannot do VCD and ASCII waveform simultaneously";
 
-  auto consumer = [&, trace_nr = 0ull](trans_tracet trace) mutable -> void {
-    namespacet ns(transition_system.symbol_table);
-    if(cmdline.isset("vcd"))
+  const auto solver_factory = ebmc_solver_factory(cmdline);
+
+  if(cmdline.isset("vcd"))
+  {
+    // the VCD files are written as the states are produced
+    PRECONDITION(outfile_prefix.has_value());
+    const namespacet ns(transition_system.symbol_table);
+
+    auto sink_factory = [&](std::size_t trace_nr)
     {
-      PRECONDITION(outfile_prefix.has_value());
       auto filename = outfile_prefix.value() + std::to_string(trace_nr + 1);
-      auto outfile = output_filet{filename};
+      auto sink = std::make_unique<vcd_file_sinkt>(ns, filename);
+      consolet::out() << "*** Writing " << sink->name() << '\n';
+      return sink;
+    };
 
-      consolet::out() << "*** Writing " << outfile.name() << '\n';
+    random_tracest(transition_system, solver_factory, message_handler)(
+      sink_factory, random_seed, number_of_traces, number_of_trace_steps);
 
-      messaget message(message_handler);
-      show_trans_trace_vcd(trace, message, ns, outfile.stream());
-    }
-    else if(cmdline.isset("waveform"))
+    return 0;
+  }
+
+  auto consumer = [&, trace_nr = 0ull](trans_tracet trace) mutable -> void {
+    namespacet ns(transition_system.symbol_table);
+    if(cmdline.isset("waveform"))
     {
       consolet::out() << "*** Trace " << (trace_nr + 1) << '\n';
       show_waveform(trace, ns);
@@ -211,8 +322,6 @@ int random_traces(const cmdlinet &cmdline, message_handlert &message_handler)
     trace_nr++;
   };
 
-  const auto solver_factory = ebmc_solver_factory(cmdline);
-
   random_tracest(transition_system, solver_factory, message_handler)(
     consumer, random_seed, number_of_traces, number_of_trace_steps);
 
@@ -336,19 +445,16 @@ void random_traces(
   message_handlert &message_handler)
 {
   std::size_t random_seed = 0;
+  const namespacet ns(transition_system.symbol_table);
 
-  auto consumer = [&, trace_nr = 0ull](trans_tracet trace) mutable -> void {
-    namespacet ns(transition_system.symbol_table);
+  auto sink_factory = [&](std::size_t trace_nr)
+  {
     auto filename = outfile_prefix + std::to_string(trace_nr + 1);
-    auto outfile = output_filet{filename};
-    messaget message(message_handler);
-    show_trans_trace_vcd(trace, message, ns, outfile.stream());
-
-    trace_nr++;
+    return std::make_unique<vcd_file_sinkt>(ns, filename);
   };
 
   random_tracest(transition_system, solver_factory, message_handler)(
-    consumer, random_seed, number_of_traces, number_of_trace_steps);
+    sink_factory, random_seed, number_of_traces, number_of_trace_steps);
 }
 
 /*******************************************************************\
@@ -548,6 +654,398 @@ std::vector<exprt> random_tracest::random_initial_state_constraints(
 
 /*******************************************************************\
 
+Function: simulation_supports
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: can bitstring_to_expr produce a value of the given type
+
+\*******************************************************************/
+
+static bool simulation_supports(const typet &type)
+{
+  if(
+    type.id() == ID_bool || type.id() == ID_unsignedbv ||
+    type.id() == ID_signedbv || type.id() == ID_range)
+  {
+    return true;
+  }
+  else if(type.id() == ID_array)
+  {
+    const auto &array_type = to_array_type(type);
+    return array_type.size().is_constant() &&
+           simulation_supports(array_type.element_type());
+  }
+  else
+    return false;
+}
+
+/*******************************************************************\
+
+Function: random_tracest::simulate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool random_tracest::simulate(
+  const sink_factoryt &sink_factory,
+  const symbolst &inputs,
+  const symbolst &unconstrained_state_variables,
+  std::size_t number_of_traces,
+  std::size_t number_of_timeframes)
+{
+  using wordt = netlist_simulatort::wordt;
+  const std::size_t lanes = netlist_simulatort::lanes;
+
+  netlistt netlist;
+
+  if(transition_system.netlist.has_value())
+    netlist = transition_system.netlist.value();
+  else
+  {
+    // the conversion adds symbols for undriven signals
+    symbol_tablet symbol_table = transition_system.symbol_table;
+
+    try
+    {
+      convert_trans_to_netlist(
+        symbol_table,
+        transition_system.main_symbol->name,
+        {},
+        netlist,
+        message.get_message_handler());
+    }
+
+    catch(const std::string &)
+    {
+      return false;
+    }
+  }
+
+  // Constraints require a solver.
+  auto is_true = [](literalt l) { return l.is_true(); };
+
+  if(
+    !std::all_of(
+      netlist.constraints.begin(), netlist.constraints.end(), is_true) ||
+    !std::all_of(netlist.transition.begin(), netlist.transition.end(), is_true))
+  {
+    return false;
+  }
+
+  auto is_latch_node = [&netlist](std::size_t n) {
+    auto it = netlist.var_map.reverse_map.find(n);
+    return it != netlist.var_map.reverse_map.end() &&
+           netlist.var_map.get_type(it->second.id) ==
+             var_mapt::vart::vartypet::LATCH;
+  };
+
+  // The initial state constraint must be a conjunction
+  // of literals of latch bits.
+  std::map<std::size_t, bool> initial_values;
+  bvt todo(netlist.initial.rbegin(), netlist.initial.rend());
+
+  while(!todo.empty())
+  {
+    literalt l = todo.back();
+    todo.pop_back();
+
+    if(l.is_true())
+      continue;
+    else if(l.is_false())
+      return false;
+
+    const auto &node = netlist.get_node(l);
+
+    if(node.is_and())
+    {
+      if(l.sign())
+        return false;
+
+      todo.push_back(node.b);
+      todo.push_back(node.a);
+    }
+    else if(is_latch_node(l.var_no()))
+    {
+      auto result = initial_values.emplace(l.var_no(), !l.sign());
+      if(result.first->second != !l.sign())
+        return false; // contradictory
+    }
+    else
+      return false;
+  }
+
+  // The bits that are given random values, in the order
+  // in which random_value generates them.
+  auto random_bits = [&netlist](const symbol_exprt &symbol, bvt &dest) {
+    const auto &type = symbol.type();
+    std::size_t width;
+
+    if(type.id() == ID_bool)
+      width = 1;
+    else if(type.id() == ID_unsignedbv || type.id() == ID_signedbv)
+      width = to_bitvector_type(type).get_width();
+    else
+      return false;
+
+    auto var_it = netlist.var_map.map.find(symbol.get_identifier());
+
+    if(
+      var_it == netlist.var_map.map.end() ||
+      var_it->second.bits.size() != width)
+    {
+      return false;
+    }
+
+    // most significant bit first
+    for(std::size_t i = 0; i < width; i++)
+    {
+      literalt l = var_it->second.bits[width - i - 1].current;
+      if(l.is_constant())
+        return false;
+      dest.push_back(l);
+    }
+
+    return true;
+  };
+
+  bvt input_bits, state_bits;
+
+  for(auto &input : inputs)
+    if(!random_bits(input, input_bits))
+      return false;
+
+  for(auto &state_variable : unconstrained_state_variables)
+    if(!random_bits(state_variable, state_bits))
+      return false;
+
+  // All latches need an initial value.
+  std::set<std::size_t> random_state_nodes;
+  for(auto l : state_bits)
+    random_state_nodes.insert(l.var_no());
+
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(var.is_latch())
+    {
+      for(const auto &bit : var.bits)
+      {
+        if(bit.current.is_constant())
+          return false;
+
+        auto n = bit.current.var_no();
+        if(initial_values.count(n) == 0 && random_state_nodes.count(n) == 0)
+          return false;
+      }
+    }
+  }
+
+  // The remaining variable nodes are free, e.g., undriven wires
+  // and the next-state values of latches that have no definition.
+  // These get new random values in every timeframe.
+  std::set<std::size_t> assigned_nodes;
+  for(auto l : input_bits)
+    assigned_nodes.insert(l.var_no());
+
+  for(const auto &[id, var] : netlist.var_map.map)
+    if(var.is_latch())
+      for(const auto &bit : var.bits)
+        assigned_nodes.insert(bit.current.var_no());
+
+  bvt free_bits;
+
+  for(std::size_t n = 0; n < netlist.number_of_nodes(); n++)
+  {
+    literalt l(n, false);
+    if(
+      !l.is_constant() && netlist.nodes[n].is_var() &&
+      assigned_nodes.count(n) == 0)
+    {
+      free_bits.push_back(l);
+    }
+  }
+
+  // The values of the free nodes come from a generator of their own,
+  // such that the inputs and the state still match the solver-based
+  // method. It is seeded from the upcoming output of the main generator.
+  std::mt19937 free_generator = [this]()
+  {
+    auto copy = generator;
+    std::seed_seq seed{copy(), copy()};
+    return std::mt19937(seed);
+  }();
+
+  // The symbols in the trace, in the order used by compute_trans_trace.
+  // The solver-based method only has values for the inputs, the initial
+  // state, and the symbols that occur in the transition system.
+  std::unordered_set<irep_idt, irep_id_hash> occurring;
+
+  transition_system.trans_expr.visit_pre(
+    [&occurring](const exprt &expr)
+    {
+      if(expr.id() == ID_symbol || expr.id() == ID_next_symbol)
+        occurring.insert(expr.get(ID_identifier));
+    });
+
+  struct trace_symbolt
+  {
+    const symbolt &symbol;
+    const var_mapt::vart *var; // no value if nullptr
+    bool initial_only;
+  };
+
+  std::vector<trace_symbolt> trace_symbols;
+
+  const irep_idt &module = transition_system.main_symbol->name;
+  const auto &symbol_module_map =
+    transition_system.symbol_table.symbol_module_map;
+
+  for(auto it = symbol_module_map.lower_bound(module);
+      it != symbol_module_map.upper_bound(module);
+      it++)
+  {
+    const symbolt &symbol = ns.lookup(it->second);
+
+    if(
+      symbol.is_type || symbol.is_property || symbol.type.id() == ID_module ||
+      symbol.type.id() == ID_module_instance)
+    {
+      continue;
+    }
+
+    if(symbol.is_macro)
+    {
+      if(symbol.value.is_constant())
+        trace_symbols.push_back({symbol, nullptr, false});
+      continue;
+    }
+
+    auto var_it = netlist.var_map.map.find(symbol.name);
+    bool in_netlist =
+      var_it != netlist.var_map.map.end() && !var_it->second.bits.empty();
+    bool occurs = occurring.find(symbol.name) != occurring.end();
+
+    if(in_netlist && (symbol.is_input || symbol.is_state_var || occurs))
+    {
+      if(!simulation_supports(symbol.type))
+        return false;
+
+      trace_symbols.push_back(
+        {symbol, &var_it->second, !symbol.is_input && !occurs});
+    }
+    else
+      trace_symbols.push_back({symbol, nullptr, false});
+  }
+
+  message.status() << "Simulating netlist, " << lanes << " traces at once"
+                   << messaget::eom;
+
+  for(std::size_t first_trace = 0; first_trace < number_of_traces;
+      first_trace += lanes)
+  {
+    const std::size_t batch_size =
+      std::min(lanes, number_of_traces - first_trace);
+
+    // Draw the random values trace by trace, in the same
+    // order as the solver-based method does.
+    std::vector<wordt> input_words(number_of_timeframes * input_bits.size(), 0);
+    std::vector<wordt> state_words(state_bits.size(), 0);
+
+    for(std::size_t lane = 0; lane < batch_size; lane++)
+    {
+      const wordt mask = wordt(1) << lane;
+
+      for(auto &word : input_words)
+        if(random_bit())
+          word |= mask;
+
+      for(auto &word : state_words)
+        if(random_bit())
+          word |= mask;
+    }
+
+    netlist_simulatort simulator(netlist);
+
+    for(const auto &[node, value] : initial_values)
+      simulator.set(literalt(node, false), value ? ~wordt(0) : wordt(0));
+
+    for(std::size_t i = 0; i < state_bits.size(); i++)
+      simulator.set(state_bits[i], state_words[i]);
+
+    std::vector<std::unique_ptr<trans_trace_sinkt>> sinks;
+    sinks.reserve(batch_size);
+
+    for(std::size_t lane = 0; lane < batch_size; lane++)
+      sinks.push_back(sink_factory(first_trace + lane));
+
+    for(std::size_t t = 0; t < number_of_timeframes; t++)
+    {
+      if(t != 0)
+        simulator.next_state();
+
+      for(std::size_t i = 0; i < input_bits.size(); i++)
+        simulator.set(input_bits[i], input_words[t * input_bits.size() + i]);
+
+      for(auto l : free_bits)
+      {
+        wordt word = free_generator();
+        word = (word << 32) | free_generator();
+        simulator.set(l, word);
+      }
+
+      simulator.evaluate();
+
+      for(std::size_t lane = 0; lane < batch_size; lane++)
+      {
+        trans_tracet::statet state;
+        auto &assignments = state.assignments;
+
+        for(const auto &trace_symbol : trace_symbols)
+        {
+          const symbolt &symbol = trace_symbol.symbol;
+          const auto *var = trace_symbol.var;
+
+          if(symbol.is_macro)
+            assignments.emplace_back(symbol.symbol_expr(), symbol.value);
+          else if(var == nullptr || (trace_symbol.initial_only && t != 0))
+            assignments.emplace_back(symbol.symbol_expr(), nil_exprt());
+          else
+          {
+            // most significant bit first
+            std::string value;
+            value.reserve(var->bits.size());
+
+            for(auto bit_it = var->bits.rbegin(); bit_it != var->bits.rend();
+                bit_it++)
+            {
+              value.push_back(simulator.get(bit_it->current, lane) ? '1' : '0');
+            }
+
+            assignments.emplace_back(
+              symbol.symbol_expr(), bitstring_to_expr(value, symbol.type));
+          }
+        }
+
+        sinks[lane]->state(state);
+      }
+    }
+
+    for(auto &sink : sinks)
+      sink->finish();
+  }
+
+  return true;
+}
+
+/*******************************************************************\
+
 Function: random_tracest::operator()()
 
   Inputs:
@@ -564,22 +1062,35 @@ void random_tracest::operator()(
   std::size_t number_of_traces,
   std::size_t number_of_trace_steps)
 {
-  generator.seed(random_seed);
+  const std::string mode = id2string(transition_system.main_symbol->mode);
 
-  auto number_of_timeframes = number_of_trace_steps + 1;
+  auto sink_factory = [&consumer, &mode](std::size_t)
+  { return std::make_unique<trans_trace_collectort>(mode, consumer); };
 
-  message.status() << "Passing transition system to solver" << messaget::eom;
+  (*this)(sink_factory, random_seed, number_of_traces, number_of_trace_steps);
+}
 
-  auto solver_container = solver_factory(ns, message.get_message_handler());
-  auto &solver = solver_container.decision_procedure();
+/*******************************************************************\
 
-  ::unwind(
-    transition_system.trans_expr,
-    message.get_message_handler(),
-    solver,
-    number_of_timeframes,
-    ns,
-    true);
+Function: random_tracest::operator()()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void random_tracest::operator()(
+  const sink_factoryt &sink_factory,
+  std::size_t random_seed,
+  std::size_t number_of_traces,
+  std::size_t number_of_trace_steps)
+{
+  generator.seed(random_seed);
+
+  auto number_of_timeframes = number_of_trace_steps + 1;
 
   auto inputs = transition_system.inputs();
 
@@ -594,12 +1105,37 @@ void random_tracest::operator()(
 
   auto unconstrained_state_variables = remove_constrained(state_variables);
 
+  if(simulate(
+       sink_factory,
+       inputs,
+       unconstrained_state_variables,
+       number_of_traces,
+       number_of_timeframes))
+  {
+    return;
+  }
+
+  message.status() << "Passing transition system to solver" << messaget::eom;
+
+  auto solver_container = solver_factory(ns, message.get_message_handler());
+  auto &solver = solver_container.decision_procedure();
+
+  ::unwind(
+    transition_system.trans_expr,
+    message.get_message_handler(),
+    solver,
+    number_of_timeframes,
+    ns,
+    true);
+
   freeze(inputs, number_of_timeframes, solver);
   freeze(unconstrained_state_variables, 1, solver);
 
   message.status() << "Solving with " << solver.decision_procedure_text()
                    << messaget::eom;
 
+  std::size_t number_of_sat_traces = 0;
+
   for(std::size_t trace_nr = 0; trace_nr < number_of_traces; trace_nr++)
   {
     auto input_constraints =
@@ -619,7 +1155,8 @@ void random_tracest::operator()(
     {
       auto trace = compute_trans_trace(
         solver, number_of_timeframes, ns, transition_system.main_symbol->name);
-      consumer(std::move(trace));
+      auto sink = sink_factory(number_of_sat_traces++);
+      output_trans_trace(trace, *sink);
     }
     break;
 
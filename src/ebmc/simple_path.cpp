@@ -0,0 +1,148 @@
+/*******************************************************************\
+
+Module: Simple-Path Constraints
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "simple_path.h"
+
+#include <util/symbol_table.h>
+
+#include <solvers/flattening/boolbv.h>
+#include <trans-word-level/instantiate_word_level.h>
+
+#include "diameter.h"
+
+#include <set>
+
+/*******************************************************************\
+
+Function: simple_path_constraintst::simple_path_constraintst
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+simple_path_constraintst::simple_path_constraintst(
+  const ebmc_solvert &_solver,
+  const namespacet &ns,
+  const irep_idt &module_identifier)
+  : solver(_solver)
+{
+  // The state is given by the state variables of the module.
+  const symbol_tablet &symbol_table = ns.get_symbol_table();
+  auto lower = symbol_table.symbol_module_map.lower_bound(module_identifier);
+  auto upper = symbol_table.symbol_module_map.upper_bound(module_identifier);
+
+  for(auto it = lower; it != upper; it++)
+  {
+    const symbolt &symbol = ns.lookup(it->second);
+
+    if(symbol.is_state_var)
+      state_variables.push_back(symbol.symbol_expr());
+  }
+}
+
+/*******************************************************************\
+
+Function: simple_path_constraintst::has_repeated_state
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool simple_path_constraintst::has_repeated_state(std::size_t k) const
+{
+  auto &decision_procedure = solver.decision_procedure();
+  std::set<exprt::operandst> states;
+
+  for(std::size_t t = 0; t <= k; t++)
+  {
+    exprt::operandst state;
+    state.reserve(state_variables.size());
+
+    for(auto &var : state_variables)
+      state.push_back(decision_procedure.get(timeframe_symbol(t, var)));
+
+    if(!states.insert(std::move(state)).second)
+      return true;
+  }
+
+  return false;
+}
+
+/*******************************************************************\
+
+Function: simple_path_constraintst::add
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void simple_path_constraintst::add(std::size_t k)
+{
+  if(k == 0 || state_variables.empty())
+    return;
+
+  auto &decision_procedure = solver.decision_procedure();
+  auto boolbv_ptr = dynamic_cast<boolbvt *>(&decision_procedure);
+
+  if(solver.prop_ptr != nullptr && boolbv_ptr != nullptr)
+  {
+    // bit-level, using the sorting network
+    std::vector<bvt> states;
+    states.reserve(k + 1);
+
+    for(std::size_t t = 0; t <= k; t++)
+    {
+      bvt state;
+
+      for(auto &var : state_variables)
+      {
+        const bvt &bv = boolbv_ptr->convert_bv(timeframe_symbol(t, var));
+        state.insert(state.end(), bv.begin(), bv.end());
+      }
+
+      states.push_back(std::move(state));
+    }
+
+    if(states.front().empty())
+      return;
+
+    literalt distinct = efficient_diameter(*solver.prop_ptr, states);
+    solver.prop_ptr->l_set_to_true(distinct);
+  }
+  else
+  {
+    // word-level, pairwise
+    for(std::size_t i = 0; i <= k; i++)
+    {
+      for(std::size_t j = i + 1; j <= k; j++)
+      {
+        exprt::operandst equal;
+
+        for(auto &var : state_variables)
+        {
+          equal.push_back(
+            equal_exprt{timeframe_symbol(i, var), timeframe_symbol(j, var)});
+        }
+
+        decision_procedure.set_to_false(conjunction(equal));
+      }
+    }
+  }
+}
@@ -0,0 +1,44 @@
+/*******************************************************************\
+
+Module: Simple-Path Constraints
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#ifndef CPROVER_EBMC_SIMPLE_PATH_H
+#define CPROVER_EBMC_SIMPLE_PATH_H
+
+#include <util/namespace.h>
+#include <util/std_expr.h>
+
+#include "ebmc_solver_factory.h"
+
+/// Simple-path constraints for the step case of k-induction, i.e.,
+/// the constraint that the states in the timeframes 0,...,k are
+/// pairwise distinct. For SAT-based solvers, these are encoded using
+/// the sorting network in diameter.cpp, which is O(n log^2 n) in the
+/// number of timeframes; for other solvers, pairwise inequalities
+/// are used.
+class simple_path_constraintst
+{
+public:
+  simple_path_constraintst(
+    const ebmc_solvert &,
+    const namespacet &,
+    const irep_idt &module_identifier);
+
+  /// Does the satisfying assignment of the solver visit a state
+  /// twice in the timeframes 0,...,k?
+  bool has_repeated_state(std::size_t k) const;
+
+  /// Adds the constraint that the states in the timeframes
+  /// 0,...,k are pairwise distinct.
+  void add(std::size_t k);
+
+protected:
+  const ebmc_solvert &solver;
+  std::vector<symbol_exprt> state_variables;
+};
+
+#endif // CPROVER_EBMC_SIMPLE_PATH_H
@@ -14,21 +14,32 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/message.h>
 #include <util/namespace.h>
 #include <util/options.h>
+#include <util/string2int.h>
+#include <util/suffix.h>
 #include <util/unicode.h>
 
 #include <langapi/language.h>
 #include <langapi/language_file.h>
 #include <langapi/language_util.h>
 #include <langapi/mode.h>
+#include <aiger/aiger_language.h>
+#include <trans-netlist/aig_opt.h>
+#include <trans-netlist/latch_correspondence.h>
+#include <trans-netlist/trans_to_netlist.h>
 #include <trans-word-level/show_module_hierarchy.h>
 #include <trans-word-level/show_modules.h>
+#include <verilog/verilog_language.h>
 
+#include "bmc_jobs.h"
+#include "design_cache.h"
 #include "ebmc_error.h"
 #include "ebmc_version.h"
 #include "output_file.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 
 static void output(
   const exprt &expr,
@@ -73,6 +84,19 @@ void transition_systemt::output(std::ostream &out) const
   ::output(trans_expr.trans(), out, *language, ns);
 }
 
+static optionst language_options(const cmdlinet &cmdline)
+{
+  optionst options;
+  options.set_option("force-systemverilog", cmdline.isset("systemverilog"));
+  options.set_option("vl2smv-extensions", cmdline.isset("vl2smv-extensions"));
+
+  // do -D
+  if(cmdline.isset('D'))
+    options.set_option("defines", cmdline.get_values('D'));
+
+  return options;
+}
+
 int preprocess(const cmdlinet &cmdline, message_handlert &message_handler)
 {
   messaget message(message_handler);
@@ -109,13 +133,7 @@ int preprocess(const cmdlinet &cmdline, message_handlert &message_handler)
     return 1;
   }
 
-  optionst options;
-  options.set_option("force-systemverilog", cmdline.isset("systemverilog"));
-  options.set_option("vl2smv-extensions", cmdline.isset("vl2smv-extensions"));
-
-  // do -D
-  if(cmdline.isset('D'))
-    options.set_option("defines", cmdline.get_values('D'));
+  const optionst options = language_options(cmdline);
 
   language->set_language_options(options, message_handler);
 
@@ -131,7 +149,8 @@ int preprocess(const cmdlinet &cmdline, message_handlert &message_handler)
 static bool parse(
   const cmdlinet &cmdline,
   const std::string &filename,
-  language_filest &language_files,
+  language_filet &lf,
+  std::optional<netlistt> &netlist,
   message_handlert &message_handler)
 {
   messaget message(message_handler);
@@ -145,7 +164,6 @@ static bool parse(
     return true;
   }
 
-  auto &lf = language_files.add_file(filename);
   lf.filename = filename;
   lf.language = get_language_from_filename(filename);
 
@@ -160,13 +178,7 @@ static bool parse(
 
   languaget &language = *lf.language;
 
-  optionst options;
-  options.set_option("force-systemverilog", cmdline.isset("systemverilog"));
-  options.set_option("vl2smv-extensions", cmdline.isset("vl2smv-extensions"));
-
-  // do -D
-  if(cmdline.isset('D'))
-    options.set_option("defines", cmdline.get_values('D'));
+  const optionst options = language_options(cmdline);
 
   language.set_language_options(options, message_handler);
 
@@ -178,24 +190,262 @@ static bool parse(
     return true;
   }
 
+  // AIGER files are parsed into a netlist directly
+  auto aiger_language = dynamic_cast<const aiger_languaget *>(&language);
+
+  if(aiger_language != nullptr)
+    netlist = aiger_language->netlist;
+
   lf.get_modules();
 
   return false;
 }
 
+static bool parse(
+  const cmdlinet &cmdline,
+  const std::string &filename,
+  language_filest &language_files,
+  std::optional<netlistt> &netlist,
+  message_handlert &message_handler)
+{
+  auto &lf = language_files.add_file(filename);
+  return parse(cmdline, filename, lf, netlist, message_handler);
+}
+
+#ifndef _WIN32
+
+/*******************************************************************\
+
+Function: parse_verilog_with_jobs
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Parses the given Verilog files using the given number of
+          jobs. The scanner, the parser and the irep data structures
+          are not thread-safe, and hence, each job is a process,
+          which sends the parse trees back as ireps. The messages
+          are replayed in the order of the files.
+
+\*******************************************************************/
+
+static bool parse_verilog_with_jobs(
+  const cmdlinet &cmdline,
+  std::size_t jobs,
+  language_filest &language_files,
+  message_handlert &message_handler)
+{
+  const auto &files = cmdline.args;
+
+  std::vector<ebmc_jobt> workers;
+
+  for(std::size_t index = 0; index < jobs; index++)
+  {
+    workers.push_back(fork_job(
+      [index, jobs, &cmdline, &files]()
+      {
+        irept results;
+
+        for(std::size_t i = index; i < files.size(); i += jobs)
+        {
+          recording_message_handlert message_handler;
+          language_filest worker_language_files;
+          auto &lf = worker_language_files.add_file(files[i]);
+          std::optional<netlistt> netlist;
+
+          bool failed =
+            parse(cmdline, files[i], lf, netlist, message_handler);
+
+          irept result;
+          result.set(ID_parse_failed, failed);
+          result.add(ID_property_messages) = message_handler.to_irep();
+
+          if(!failed)
+          {
+            auto &parse_tree =
+              dynamic_cast<verilog_languaget &>(*lf.language).get_parse_tree();
+            result.set(
+              ID_parse_standard, static_cast<int>(parse_tree.standard));
+            auto &items = result.add(ID_parse_items).get_sub();
+            items.reserve(parse_tree.items.size());
+            for(auto &item : parse_tree.items)
+              items.push_back(std::move(item));
+          }
+
+          results.get_sub().push_back(std::move(result));
+
+          // stop at the first error, as the sequential parser does
+          if(failed)
+            break;
+        }
+
+        return results;
+      }));
+  }
+
+  std::vector<irept> results;
+  results.reserve(jobs);
+
+  for(auto &job : workers)
+    results.push_back(wait_job(job));
+
+  for(std::size_t i = 0; i < files.size(); i++)
+  {
+    auto &worker_results = results[i % jobs].get_sub();
+    std::size_t result_index = i / jobs;
+
+    if(result_index >= worker_results.size())
+      throw ebmc_errort() << "parsing job failed";
+
+    auto &result = worker_results[result_index];
+
+    recording_message_handlert::replay(
+      result.find(ID_property_messages), message_handler);
+
+    if(result.get_bool(ID_parse_failed))
+      return true;
+
+    const auto &filename = files[i];
+    auto &lf = language_files.add_file(filename);
+    lf.filename = filename;
+    lf.language = get_language_from_filename(filename);
+
+    lf.language->set_language_options(
+      language_options(cmdline), message_handler);
+
+    auto &parse_tree =
+      dynamic_cast<verilog_languaget &>(*lf.language).get_parse_tree();
+    parse_tree.standard =
+      static_cast<verilog_standardt>(result.get_int(ID_parse_standard));
+
+    for(auto &item : result.find(ID_parse_items).get_sub())
+      parse_tree.add_item(item);
+
+    parse_tree.build_module_map();
+    lf.get_modules();
+  }
+
+  return false;
+}
+
+#endif
+
 bool parse(
   const cmdlinet &cmdline,
   language_filest &language_files,
+  std::optional<netlistt> &netlist,
   message_handlert &message_handler)
 {
+#ifndef _WIN32
+  std::size_t jobs = cmdline.isset("jobs")
+                       ? unsafe_string2size_t(cmdline.get_value("jobs"))
+                       : 1;
+
+  jobs = std::min(jobs, cmdline.args.size());
+
+  // Files other than Verilog files, say AIGER files, are parsed
+  // sequentially.
+  bool all_verilog = std::all_of(
+    cmdline.args.begin(),
+    cmdline.args.end(),
+    [](const std::string &filename)
+    { return has_suffix(filename, ".v") || has_suffix(filename, ".sv"); });
+
+  if(jobs > 1 && all_verilog)
+  {
+    return parse_verilog_with_jobs(
+      cmdline, jobs, language_files, message_handler);
+  }
+#endif
+
   for(unsigned i = 0; i < cmdline.args.size(); i++)
   {
-    if(parse(cmdline, cmdline.args[i], language_files, message_handler))
+    if(parse(
+         cmdline,
+         cmdline.args[i],
+         language_files,
+         netlist,
+         message_handler))
       return true;
   }
   return false;
 }
 
+/*******************************************************************\
+
+Function: design_cache_key
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Adds everything the front end depends on to the key of the
+          design cache. The key includes the preprocessed files,
+          and hence, changes to included files are noticed.
+          Returns false if the design cannot be cached.
+
+\*******************************************************************/
+
+static bool
+design_cache_key(const cmdlinet &cmdline, design_cachet &design_cache)
+{
+  design_cache.add_to_key(EBMC_VERSION);
+
+  for(auto option : {"systemverilog", "vl2smv-extensions"})
+    design_cache.add_to_key(cmdline.isset(option) ? "1" : "0");
+
+  for(auto option : {'D', 'I'})
+  {
+    design_cache.add_to_key(std::string(1, option));
+    for(auto &value : cmdline.get_values(option))
+      design_cache.add_to_key(value);
+  }
+
+  for(auto option : {"top", "module"})
+  {
+    design_cache.add_to_key(option);
+    for(auto &value : cmdline.get_values(option))
+      design_cache.add_to_key(value);
+  }
+
+  null_message_handlert null_message_handler;
+
+  for(auto &filename : cmdline.args)
+  {
+    // Netlists (AIGER) are not kept in the symbol table,
+    // and hence, only Verilog designs are cached.
+    if(!has_suffix(filename, ".v") && !has_suffix(filename, ".sv"))
+      return false;
+
+    std::ifstream infile(widen_if_needed(filename));
+
+    if(!infile)
+      return false;
+
+    auto language = get_language_from_filename(filename);
+
+    if(language == nullptr)
+      return false;
+
+    language->set_language_options(
+      language_options(cmdline), null_message_handler);
+
+    std::ostringstream preprocessed;
+
+    if(language->preprocess(
+         infile, filename, preprocessed, null_message_handler))
+    {
+      return false;
+    }
+
+    design_cache.add_to_key(filename);
+    design_cache.add_to_key(preprocessed.str());
+  }
+
+  return true;
+}
+
 bool get_main(
   const cmdlinet &cmdline,
   message_handlert &message_handler,
@@ -247,30 +497,63 @@ int get_transition_system(
   if(cmdline.isset("preprocess"))
     return preprocess(cmdline, message_handler);
 
-  //
-  // parsing
-  //
-  language_filest language_files;
-
-  if(parse(cmdline, language_files, message_handler))
-    return 1;
+  // The design cache holds the symbol table after type checking,
+  // and is not used when the output of the front end is requested.
+  std::optional<design_cachet> design_cache;
 
-  if(cmdline.isset("show-parse"))
+  if(
+    cmdline.isset("design-cache") && !cmdline.isset("show-parse") &&
+    !cmdline.isset("show-modules") && !cmdline.isset("modules-xml") &&
+    !cmdline.isset("json-modules") && !cmdline.isset("show-symbol-table") &&
+    !cmdline.isset("show-module-hierarchy"))
   {
-    language_files.show_parse(std::cout, message_handler);
-    return 0;
+    design_cache.emplace(cmdline.get_value("design-cache"));
+    if(!design_cache_key(cmdline, *design_cache))
+      design_cache.reset();
   }
 
-  //
-  // type checking
-  //
+  std::optional<symbol_tablet> cached_symbol_table;
 
-  message.status() << "Converting" << messaget::eom;
+  if(design_cache.has_value())
+    cached_symbol_table = design_cache->read();
 
-  if(language_files.typecheck(transition_system.symbol_table, message_handler))
+  if(cached_symbol_table.has_value())
   {
-    message.error() << "CONVERSION ERROR" << messaget::eom;
-    return 2;
+    message.status() << "Using cached design" << messaget::eom;
+    transition_system.symbol_table = std::move(*cached_symbol_table);
+  }
+  else
+  {
+    //
+    // parsing
+    //
+    language_filest language_files;
+
+    if(parse(
+         cmdline, language_files, transition_system.netlist, message_handler))
+      return 1;
+
+    if(cmdline.isset("show-parse"))
+    {
+      language_files.show_parse(std::cout, message_handler);
+      return 0;
+    }
+
+    //
+    // type checking
+    //
+
+    message.status() << "Converting" << messaget::eom;
+
+    if(language_files.typecheck(
+         transition_system.symbol_table, message_handler))
+    {
+      message.error() << "CONVERSION ERROR" << messaget::eom;
+      return 2;
+    }
+
+    if(design_cache.has_value())
+      design_cache->write(transition_system.symbol_table, message_handler);
   }
 
   if(cmdline.isset("show-modules"))
@@ -351,6 +634,46 @@ transition_systemt get_transition_system(
   return transition_system;
 }
 
+void convert_to_netlist(
+  const transition_systemt &transition_system,
+  const std::map<irep_idt, exprt> &properties,
+  netlistt &dest,
+  message_handlert &message_handler)
+{
+  if(transition_system.netlist.has_value())
+  {
+    dest = transition_system.netlist.value();
+  }
+  else
+  {
+    // the conversion adds symbols for undriven signals
+    symbol_tablet symbol_table = transition_system.symbol_table;
+
+    convert_trans_to_netlist(
+      symbol_table,
+      transition_system.main_symbol->name,
+      properties,
+      dest,
+      message_handler);
+  }
+}
+
+void convert_to_netlist(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  const std::map<irep_idt, exprt> &properties,
+  netlistt &dest,
+  message_handlert &message_handler)
+{
+  convert_to_netlist(transition_system, properties, dest, message_handler);
+
+  if(cmdline.isset("latch-correspondence"))
+    dest = latch_correspondence(dest, message_handler);
+
+  if(cmdline.isset("aig-opt"))
+    dest = aig_opt(dest, message_handler);
+}
+
 int show_parse(const cmdlinet &cmdline, message_handlert &message_handler)
 {
   transition_systemt dummy_transition_system;
@@ -13,6 +13,10 @@ Author: Daniel Kroening, dkr@amazon.com
 #include <util/std_expr.h>
 #include <util/symbol_table.h>
 
+#include <trans-netlist/netlist.h>
+
+#include <optional>
+
 class cmdlinet;
 class message_handlert;
 
@@ -28,6 +32,10 @@ public:
   const symbolt *main_symbol;
   transt trans_expr; // transition system expression
 
+  // Designs that are given as netlists (AIGER) come with
+  // the netlist, and have no word-level transition relation.
+  std::optional<netlistt> netlist;
+
   void output(std::ostream &) const;
 
   std::vector<symbol_exprt> state_variables() const;
@@ -36,6 +44,24 @@ public:
 
 transition_systemt get_transition_system(const cmdlinet &, message_handlert &);
 
+/// Builds the netlist for the given transition system and properties,
+/// or copies it when the design was given as a netlist.
+void convert_to_netlist(
+  const transition_systemt &,
+  const std::map<irep_idt, exprt> &properties,
+  netlistt &,
+  message_handlert &);
+
+/// As above, and then merges equivalent latches when
+/// --latch-correspondence is given, and optimizes the netlist when
+/// --aig-opt is given.
+void convert_to_netlist(
+  const cmdlinet &,
+  const transition_systemt &,
+  const std::map<irep_idt, exprt> &properties,
+  netlistt &,
+  message_handlert &);
+
 int preprocess(const cmdlinet &, message_handlert &);
 int show_parse(const cmdlinet &, message_handlert &);
 int show_modules(const cmdlinet &, message_handlert &);
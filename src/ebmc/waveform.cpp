@@ -18,32 +18,6 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <map>
 #include <unordered_set>
 
-std::vector<irep_idt>
-lhs_symbols(const trans_tracet &trace, const namespacet &ns)
-{
-  std::unordered_set<irep_idt, irep_id_hash> identifier_set;
-
-  for(auto &state : trace.states)
-    for(auto &assignment : state.assignments)
-    {
-      auto &lhs = assignment.lhs;
-      if(lhs.id() == ID_symbol)
-      {
-        auto identifier = to_symbol_expr(lhs).get_identifier();
-        auto &symbol = ns.lookup(identifier);
-        if(!symbol.is_auxiliary)
-          identifier_set.insert(identifier);
-      }
-    }
-
-  std::vector<irep_idt> result;
-
-  for(auto identifier : identifier_set)
-    result.push_back(identifier);
-
-  return result;
-}
-
 std::size_t
 max_name_width(const std::vector<irep_idt> &identifiers, const namespacet &ns)
 {
@@ -58,20 +32,54 @@ max_name_width(const std::vector<irep_idt> &identifiers, const namespacet &ns)
   return width;
 }
 
-std::vector<std::string> values(const trans_tracet &trace)
+void show_waveform(const trans_tracet &trace, const namespacet &ns)
 {
-  return {};
+  waveform_sinkt sink(ns);
+  output_trans_trace(trace, sink);
 }
 
-void show_waveform(const trans_tracet &trace, const namespacet &ns)
+void show_waveform(const packed_trans_tracet &trace, const namespacet &ns)
 {
-  auto y_identifiers = lhs_symbols(trace, ns);
+  waveform_sinkt sink(ns);
+  output_trans_trace(trace, sink);
+}
+
+void waveform_sinkt::state(const trans_tracet::statet &state)
+{
+  const std::size_t timeframe = column_width.size();
+  column_width.push_back(0);
+
+  for(auto &assignment : state.assignments)
+  {
+    auto &lhs = assignment.lhs;
+    if(lhs.id() == ID_symbol)
+    {
+      auto identifier = to_symbol_expr(lhs).get_identifier();
+      auto &symbol = ns.lookup(identifier);
+      if(!symbol.is_auxiliary)
+        identifiers.insert(identifier);
+
+      if(assignment.rhs.is_not_nil())
+      {
+        auto as_string = from_expr(ns, identifier, assignment.rhs);
+        auto &width = column_width[timeframe];
+        width = std::max(width, as_string.size());
+        width = std::max(width, std::size_t(2));
+        value_map[std::make_pair(identifier, timeframe)] = std::move(as_string);
+      }
+    }
+  }
+}
+
+void waveform_sinkt::finish()
+{
+  std::vector<irep_idt> y_identifiers(identifiers.begin(), identifiers.end());
 
   // sort by display_name
   std::sort(
     y_identifiers.begin(),
     y_identifiers.end(),
-    [&ns](const irep_idt &a, const irep_idt &b) {
+    [this](const irep_idt &a, const irep_idt &b) {
       auto &a_symbol = ns.lookup(a);
       auto &b_symbol = ns.lookup(b);
       auto &a_name = a_symbol.display_name();
@@ -79,30 +87,6 @@ void show_waveform(const trans_tracet &trace, const namespacet &ns)
       return a_name.compare(b_name) < 0;
     });
 
-  std::map<std::pair<irep_idt, std::size_t>, std::string> value_map;
-  std::map<std::size_t, std::size_t> column_width;
-
-  for(std::size_t timeframe = 0; timeframe < trace.states.size(); timeframe++)
-  {
-    auto &state = trace.states[timeframe];
-    for(auto &assignment : state.assignments)
-    {
-      auto &lhs = assignment.lhs;
-      if(lhs.id() == ID_symbol)
-      {
-        auto identifier = to_symbol_expr(lhs).get_identifier();
-        if(assignment.rhs.is_not_nil())
-        {
-          auto as_string = from_expr(ns, identifier, assignment.rhs);
-          value_map[std::make_pair(identifier, timeframe)] = as_string;
-          auto &width = column_width[timeframe];
-          width = std::max(width, as_string.size());
-          width = std::max(width, std::size_t(2));
-        }
-      }
-    }
-  }
-
   auto y_label_width = max_name_width(y_identifiers, ns);
 
   {
@@ -110,7 +94,7 @@ void show_waveform(const trans_tracet &trace, const namespacet &ns)
     consolet::out().width(y_label_width);
     consolet::out() << "";
 
-    for(std::size_t x = 0; x < trace.states.size(); x++)
+    for(std::size_t x = 0; x < column_width.size(); x++)
     {
       consolet::out() << ' ';
       if(consolet::is_terminal() && consolet::use_SGR())
@@ -135,7 +119,7 @@ void show_waveform(const trans_tracet &trace, const namespacet &ns)
     consolet::out() << symbol.display_name();
     consolet::out() << consolet::reset;
 
-    for(std::size_t x = 0; x < trace.states.size(); x++)
+    for(std::size_t x = 0; x < column_width.size(); x++)
     {
       consolet::out() << ' ';
       if(consolet::is_terminal() && consolet::use_SGR())
@@ -9,8 +9,35 @@ Author: Daniel Kroening, kroening@kroening.com
 #ifndef CPROVER_EBMC_WAVEFORM_H
 #define CPROVER_EBMC_WAVEFORM_H
 
-#include <trans-netlist/trans_trace.h>
+#include <trans-netlist/packed_trans_trace.h>
+
+#include <map>
+#include <unordered_set>
+#include <vector>
 
 void show_waveform(const trans_tracet &, const namespacet &);
+void show_waveform(const packed_trans_tracet &, const namespacet &);
+
+/// The waveform has one column per state, and hence, can only be
+/// shown once the trace is complete. This sink only keeps the values
+/// as strings, not the states.
+class waveform_sinkt : public trans_trace_sinkt
+{
+public:
+  explicit waveform_sinkt(const namespacet &_ns) : ns(_ns)
+  {
+  }
+
+  void state(const trans_tracet::statet &) override;
+  void finish() override;
+
+protected:
+  const namespacet &ns;
+  std::unordered_set<irep_idt, irep_id_hash> identifiers;
+  std::map<std::pair<irep_idt, std::size_t>, std::string> value_map;
+
+  // one per state
+  std::vector<std::size_t> column_width;
+};
 
 #endif
@@ -254,3 +254,15 @@ IREP_ID_ONE(to_be_elaborated)
 IREP_ID_ONE(elaborating)
 IREP_ID_ONE(derive_from_value)
 IREP_ID_ONE(variables)
+IREP_ID_ONE(trans_trace)
+IREP_ID_ONE(trans_trace_state)
+IREP_ID_ONE(trans_trace_assignment)
+IREP_ID_ONE(property_failed)
+IREP_ID_ONE(property_status)
+IREP_ID_ONE(property_bound)
+IREP_ID_ONE(property_failure_reason)
+IREP_ID_ONE(property_messages)
+IREP_ID_ONE(message_level)
+IREP_ID_ONE(parse_failed)
+IREP_ID_ONE(parse_standard)
+IREP_ID_ONE(parse_items)
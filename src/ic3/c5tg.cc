@@ -76,6 +76,10 @@ void CompInfo::lift_ctg_state(CUBE &Ctg_cube,CUBE &Ctg_st,CUBE &Inps,
 
   gcount++;
 
+  // try ternary simulation first
+  if (tern_lift_applies())
+    if (tern_lift(Ctg_cube,Ctg_st,Inps,Nst_cube)) return;
+
   // add unit clauses specifying inputs
   MvecLits Assmps;
   add_assumps1(Assmps,Inps);
@@ -1,14 +1,16 @@
 typedef std::vector<std::string> GateNames;
 typedef std::map<int,int> LatchVal;
 typedef std::map<int,int> NondetVars;
+typedef std::map<unsigned,int> LatchGates;
+typedef std::set<bvt> LatchClauses;
 //
 class ic3_enginet
 {
 public:
   ic3_enginet(
     const cmdlinet &_cmdline,
-    ui_message_handlert &_ui_message_handler)
-    : cmdline(_cmdline), message(_ui_message_handler)
+    message_handlert &_message_handler)
+    : cmdline(_cmdline), message(_message_handler)
   {
   }
 
@@ -26,10 +28,29 @@ public:
   literalt prop_l;
   LatchVal Latch_val;
   NondetVars Nondet_vars;
+  LatchGates Latch_gates; // the gate of each latch variable of the netlist
   bool const0,const1;
   bool orig_names;
 
   int operator()();
+  int check_property(
+    const netlistt &_netlist,
+    const ebmc_propertiest &_properties,
+    const irep_idt &identifier,
+    LatchClauses &lemmas);
+  int check_properties(const transition_systemt &transition_system);
+  int check_properties(
+    const transition_systemt &transition_system,
+    ebmc_propertiest &_properties);
+  void witness_trace(
+    const namespacet &ns,
+    propertyt &property,
+    std::size_t length);
+  void select_property(
+    const ebmc_propertiest &_properties,
+    const irep_idt &identifier);
+  void import_lemmas(const LatchClauses &Cls);
+  void export_lemmas(LatchClauses &Cls);
   void read_ebmc_input();  
   void find_prop_lit();
   void ebmc_form_latches();
@@ -59,6 +59,7 @@ void CompInfo::ci_init()
   length_bstate_cubes = 0.;  
   num_gstate_cubes = 0; 
   length_gstate_cubes = 0.; 
+  num_tern_lifts = 0;
   old_state_cnt = 0;
   triv_old_st_cnt = 0;
   new_state_cnt = 0;
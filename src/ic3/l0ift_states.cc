@@ -31,6 +31,14 @@ void CompInfo::lift_good_state(CUBE &Gst_cube,CUBE &Prs_st,
                                CUBE &Inps,CUBE &Nst_cube)
 {
 
+  // try ternary simulation first
+  if (tern_lift_applies())
+    if (tern_lift(Gst_cube,Prs_st,Inps,Nst_cube)) {
+      num_gstate_cubes++;
+      length_gstate_cubes += Gst_cube.size();
+      return;
+    }
+
   // add unit clauses specifying inputs
   MvecLits Assmps;
   CUBE Inps1;
@@ -79,6 +87,19 @@ void CompInfo::lift_good_state(CUBE &Gst_cube,CUBE &Prs_st,
 void CompInfo::lift_bad_state(CUBE &Bst_cube,CUBE &St,CUBE &Inps)
 {
 
+  // try ternary simulation first: the unit clause
+  // of 'Prop' has to stay falsified
+  if (tern_lift_applies()) {
+    assert(Prop.back().size() == 1);
+    CUBE Trg;
+    Trg.push_back(-Prop.back()[0]);
+    if (tern_lift(Bst_cube,St,Inps,Trg)) {
+      num_bstate_cubes++;
+      length_bstate_cubes += Bst_cube.size();
+      return;
+    }
+  }
+
   TrivMclause Assmps;
 
   CUBE Inps1;
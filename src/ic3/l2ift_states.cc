@@ -0,0 +1,293 @@
+/******************************************************
+
+Module: Lifting states by ternary simulation
+        (Part 3)
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <iostream>
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+/*=============================================
+
+   T E R N _ L I F T _ A P P L I E S
+
+  Ternary simulation does not take into account
+  constraints. So in their presence, states are
+  lifted by the sat-solver
+
+  ============================================*/
+bool CompInfo::tern_lift_applies()
+{
+
+  if (ternary_lift == false) return(false);
+
+  if (Constr_ilits.size() > 0) return(false);
+  if (Constr_nilits.size() > 0) return(false);
+  if (Constr_ps_lits.size() > 0) return(false);
+  if (Constr_inp_lits.size() > 0) return(false);
+
+  return(true);
+
+} /* end of function tern_lift_applies */
+
+/*==============================================
+
+  F O R M _ T E R N _ G A T E _ O R D E R
+
+  Places the combinational gates of N in
+  'Tern_order' so that every gate follows
+  the gates feeding it. Inputs and latches
+  are not placed
+
+  ===============================================*/
+void CompInfo::form_tern_gate_order()
+{
+
+  size_t num_gates = N->Gate_list.size();
+  Tern_order.clear();
+  Tern_pos.assign(num_gates,-1);
+  Tern_vals.assign(num_gates,2);
+  Tern_trg.assign(num_gates,2);
+  Tern_queued.assign(num_gates,0);
+
+  // 0 - not visited, 1 - on the stack, 2 - placed
+  CCUBE Mark(num_gates,0);
+
+  for (size_t i=0; i < num_gates; i++) {
+    if (N->get_gate(i).gate_type != GATE) continue;
+    if (Mark[i] == 2) continue;
+
+    CUBE Stack;
+    Stack.push_back(i);
+    while (Stack.size() > 0) {
+      int gate_ind = Stack.back();
+      if (Mark[gate_ind] == 2) {
+        Stack.pop_back();
+        continue;
+      }
+
+      Mark[gate_ind] = 1;
+      Gate &G = N->get_gate(gate_ind);
+      bool ready = true;
+      for (size_t j=0; j < G.Fanin_list.size(); j++) {
+        int fanin_ind = G.Fanin_list[j];
+        if (N->get_gate(fanin_ind).gate_type != GATE) continue;
+        if (Mark[fanin_ind] != 0) continue;
+        Stack.push_back(fanin_ind);
+        ready = false;
+      }
+
+      if (ready) {
+        Stack.pop_back();
+        Mark[gate_ind] = 2;
+        Tern_pos[gate_ind] = Tern_order.size();
+        Tern_order.push_back(gate_ind);
+      }
+    }
+  }
+
+} /* end of function form_tern_gate_order */
+
+/*=========================================
+
+     T E R N _ G A T E _ V A L
+
+  Returns the value of gate 'G' (0, 1 or
+  2 i.e. unknown) given the values of its
+  fanin gates. The output polarity is
+  ignored as it is done when generating
+  CNF formulas
+
+  ========================================*/
+char CompInfo::tern_gate_val(Gate &G)
+{
+
+  switch (G.func_type) {
+  case CONST:
+    return((G.F.size() == 1) ? 1 : 0);
+
+  case BUFFER:
+  case AND:
+  case OR: {
+    bool unknown = false;
+    for (size_t i=0; i < G.Fanin_list.size(); i++) {
+      char val = Tern_vals[G.Fanin_list[i]];
+      if (val == 2) {
+        unknown = true;
+        continue;
+      }
+      if (G.Polarity[i] == 1) val = 1 - val;
+      if ((G.func_type == OR) && (val == 1)) return(1);
+      if ((G.func_type != OR) && (val == 0)) return(0);
+    }
+    if (unknown) return(2);
+    return((G.func_type == OR) ? 0 : 1);
+  }
+
+  case TRUTH_TABLE: {
+    // the ON-set consists of complete cubes
+    bool unknown = false;
+    for (size_t i=0; i < G.F.size(); i++) {
+      CUBE &C = G.F[i];
+      char cube_val = 1;
+      for (size_t j=0; j < C.size(); j++) {
+        char val = Tern_vals[G.Fanin_list[abs(C[j])-1]];
+        if ((val != 2) && (C[j] < 0)) val = 1 - val;
+        if (val == 0) {
+          cube_val = 0;
+          break;
+        }
+        if (val == 2) cube_val = 2;
+      }
+      if (cube_val == 1) return(1);
+      if (cube_val == 2) unknown = true;
+    }
+    return(unknown ? 2 : 0);
+  }
+
+  default:
+    return(2);
+  }
+
+} /* end of function tern_gate_val */
+
+/*=========================================
+
+      T E R N _ S E T _ U N K N O W N
+
+  Makes the value of gate 'gate_ind' (an
+  input or a latch) unknown and propagates
+  the change. Returns 'false' and restores
+  the previous values if a gate of 'Tern_trg'
+  becomes unknown
+
+  ========================================*/
+bool CompInfo::tern_set_unknown(int gate_ind)
+{
+
+  CUBE Changed;
+  CCUBE Old_vals;
+
+  // the positions of the gates to re-evaluate in 'Tern_order'
+  std::priority_queue<int,CUBE,std::greater<int> > Queue;
+
+  Changed.push_back(gate_ind);
+  Old_vals.push_back(Tern_vals[gate_ind]);
+  Tern_vals[gate_ind] = 2;
+
+  bool ok = true;
+  int curr_ind = gate_ind;
+
+  while (true) {
+    // values only change from known to unknown
+    if (Tern_trg[curr_ind] != 2) {
+      ok = false;
+      break;
+    }
+
+    Gate &G = N->get_gate(curr_ind);
+    for (size_t i=0; i < G.Fanout_list.size(); i++) {
+      int fanout_ind = G.Fanout_list[i];
+      if (Tern_pos[fanout_ind] < 0) continue;
+      if (Tern_queued[fanout_ind]) continue;
+      Tern_queued[fanout_ind] = 1;
+      Queue.push(Tern_pos[fanout_ind]);
+    }
+
+    curr_ind = -1;
+    while (Queue.size() > 0) {
+      int ind = Tern_order[Queue.top()];
+      Queue.pop();
+      Tern_queued[ind] = 0;
+      char val = tern_gate_val(N->get_gate(ind));
+      if (val == Tern_vals[ind]) continue;
+      Changed.push_back(ind);
+      Old_vals.push_back(Tern_vals[ind]);
+      Tern_vals[ind] = val;
+      curr_ind = ind;
+      break;
+    }
+
+    if (curr_ind < 0) break;
+  }
+
+  if (ok) return(true);
+
+  while (Queue.size() > 0) {
+    Tern_queued[Tern_order[Queue.top()]] = 0;
+    Queue.pop();
+  }
+
+  for (size_t i=0; i < Changed.size(); i++)
+    Tern_vals[Changed[i]] = Old_vals[i];
+
+  return(false);
+
+} /* end of function tern_set_unknown */
+
+/*==============================================
+
+              T E R N _ L I F T
+
+  Returns 'true' if the assignments 'Inps' and
+  'St' imply the literals of 'Trg'. In this case,
+  'St_cube' consists of the literals of 'St' that
+  are still needed after the other ones are made
+  unknown one by one. Returns 'false' otherwise
+  (e.g. if N has a complex gate).
+
+  ASSUMPTIONS:
+   1) 'Inps' and 'St' are given in terms of
+      input and present state variables
+   2) The variables of 'Trg' are those of
+      combinational gates
+
+  =============================================*/
+bool CompInfo::tern_lift(CUBE &St_cube,CUBE &St,CUBE &Inps,CUBE &Trg)
+{
+
+  if (Tern_vals.size() != N->Gate_list.size()) form_tern_gate_order();
+
+  Tern_vals.assign(N->Gate_list.size(),2);
+
+  for (size_t i=0; i < Inps.size(); i++)
+    Tern_vals[abs(Inps[i])-1] = (Inps[i] > 0) ? 1 : 0;
+
+  for (size_t i=0; i < St.size(); i++)
+    Tern_vals[abs(St[i])-1] = (St[i] > 0) ? 1 : 0;
+
+  for (size_t i=0; i < Tern_order.size(); i++) {
+    int gate_ind = Tern_order[i];
+    Tern_vals[gate_ind] = tern_gate_val(N->get_gate(gate_ind));
+  }
+
+  bool ok = true;
+  for (size_t i=0; i < Trg.size(); i++) {
+    int gate_ind = abs(Trg[i])-1;
+    char val = (Trg[i] > 0) ? 1 : 0;
+    if (Tern_vals[gate_ind] != val) ok = false;
+    Tern_trg[gate_ind] = val;
+  }
+
+  if (ok)
+    for (size_t i=0; i < St.size(); i++)
+      if (!tern_set_unknown(abs(St[i])-1))
+        St_cube.push_back(St[i]);
+
+  for (size_t i=0; i < Trg.size(); i++)
+    Tern_trg[abs(Trg[i])-1] = 2;
+
+  if (ok) num_tern_lifts++;
+  return(ok);
+
+} /* end of function tern_lift */
@@ -0,0 +1,181 @@
+/******************************************************
+
+Module: Reusing the clauses learned when checking
+        other properties of the same circuit
+
+Author: Eugene Goldberg, eu.goldberg@gmail.com
+
+******************************************************/
+#include <iostream>
+#include <queue>
+#include <set>
+#include <map>
+#include <algorithm>
+#include "minisat/core/Solver.h"
+#include "minisat/simp/SimpSolver.h"
+#include "dnf_io.hh"
+#include "ccircuit.hh"
+#include "m0ic3.hh"
+
+#include <ebmc/ebmc_base.h>
+#include <util/cmdline.h>
+#include "ebmc_ic3_interface.hh"
+
+/*==========================================
+
+       F I L T E R _ L E M M A S
+
+  Removes from 'Lemmas' the clauses that
+  exclude an initial state. Then removes the
+  clauses that are not implied by 'Lemmas'
+  and the transition relation until 'Lemmas'
+  is inductive. The property is not used,
+  as the clauses are learned for another one
+
+  =========================================*/
+void CompInfo::filter_lemmas()
+{
+
+  std::string Name = "Gen_sat";
+  init_sat_solver(Gen_sat,max_num_vars,Name);
+  accept_new_clauses(Gen_sat,Ist);
+  accept_constrs(Gen_sat);
+
+  CNF H;
+  for (size_t i=0; i < Lemmas.size(); i++) {
+    MvecLits Assmps;
+    add_negated_assumps1(Assmps,Lemmas[i]);
+    bool sat_form = check_sat2(Gen_sat,Assmps);
+    if (sat_form == false) H.push_back(Lemmas[i]);
+  }
+
+  delete_solver(Gen_sat);
+
+  while (H.size() > 0) {
+    init_sat_solver(Gen_sat,max_num_vars,Name);
+    accept_new_clauses(Gen_sat,Tr);
+    accept_new_clauses(Gen_sat,H);
+
+    CNF H1;
+    for (size_t i=0; i < H.size(); i++) {
+      CLAUSE C;
+      conv_to_next_state(C,H[i]);
+      MvecLits Assmps;
+      add_negated_assumps1(Assmps,C);
+      bool sat_form = check_sat2(Gen_sat,Assmps);
+      if (sat_form == false) H1.push_back(H[i]);
+    }
+
+    delete_solver(Gen_sat);
+    if (H1.size() == H.size()) break;
+    H = H1;
+  }
+
+  Lemmas = H;
+
+} /* end of function filter_lemmas */
+
+/*==================================
+
+       A D D _ L E M M A S
+
+  Adds the inductive clauses of
+  'Lemmas' to F_1. Since they hold
+  in all reachable states, they are
+  pushed forward as the other
+  clauses of F
+
+  ===================================*/
+void CompInfo::add_lemmas()
+{
+
+  size_t num_cands = Lemmas.size();
+  filter_lemmas();
+  printf("%d of %d lemmas are inductive\n",(int) Lemmas.size(),
+	 (int) num_cands);
+
+  for (size_t i=0; i < Lemmas.size(); i++) {
+    CLAUSE C = Lemmas[i];
+    add_fclause1(C,1,LEMMA_STATE);
+  }
+
+} /* end of function add_lemmas */
+
+/*==================================
+
+       E X T R _ L E M M A S
+
+  Adds to 'H' the clauses of the
+  invariant, if there is one, or
+  those of the last time frame
+
+  ===================================*/
+void CompInfo::extr_lemmas(CNF &H)
+{
+
+  if (Time_frames.size() < 2) return;
+
+  if (inv_ind >= 0) gen_form1(H,inv_ind+1);
+  else gen_form1(H,Time_frames.size()-1);
+
+} /* end of function extr_lemmas */
+
+/*==================================
+
+      I M P O R T _ L E M M A S
+
+  Gives to IC3 the clauses of 'Cls'
+  that are expressed in terms of
+  the latches of the netlist
+
+  ===================================*/
+void ic3_enginet::import_lemmas(const LatchClauses &Cls)
+{
+
+  for (auto &Lits : Cls) {
+    CLAUSE C;
+    for (auto &lit : Lits) {
+      auto pnt = Latch_gates.find(lit.var_no());
+      if (pnt == Latch_gates.end()) break;
+      int var = Ci.Gate_to_var[pnt->second];
+      C.push_back(lit.sign() ? -var : var);
+    }
+    if (C.size() == Lits.size())
+      Ci.Lemmas.push_back(C);
+  }
+
+} /* end of function import_lemmas */
+
+/*==================================
+
+      E X P O R T _ L E M M A S
+
+  Adds to 'Cls' the clauses that IC3
+  learned, in terms of the latches
+  of the netlist
+
+  ===================================*/
+void ic3_enginet::export_lemmas(LatchClauses &Cls)
+{
+
+  std::map<int,unsigned> Var_to_latch;
+  for (auto &pair : Latch_gates)
+    Var_to_latch[Ci.Gate_to_var[pair.second]] = pair.first;
+
+  CNF H;
+  Ci.extr_lemmas(H);
+
+  for (size_t i=0; i < H.size(); i++) {
+    bvt Lits;
+    for (size_t j=0; j < H[i].size(); j++) {
+      int lit = H[i][j];
+      auto pnt = Var_to_latch.find(abs(lit));
+      if (pnt == Var_to_latch.end()) break;
+      Lits.push_back(literalt(pnt->second,lit < 0));
+    }
+    if (Lits.size() < H[i].size()) continue;
+    std::sort(Lits.begin(),Lits.end());
+    Cls.insert(Lits);
+  }
+
+} /* end of function export_lemmas */
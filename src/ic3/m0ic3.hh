@@ -148,6 +148,10 @@ public:
 
   DNF Cex; // a counterexample in terms of states extracted from 'Obl_table'
 
+  CNF Lemmas; // clauses over present state variables learned when checking
+              // other properties of the same circuit. Only the clauses that
+              // are inductive are added to F (see 'add_lemmas')
+
 
   CNF Bad_states; // bad states expressed in terms of next state variables
 
@@ -198,6 +202,9 @@ public:
   int sorted_objects; // specifies whether literals or variables are sorted
   int lift_sort_mode; // value of this variable controls how assumptions 
                       // are sorted when lifting a state
+  bool ternary_lift; // if 'true', states are first lifted by ternary
+                     // simulation, the sat-solver is used only if it fails
+                     // or if there are constraints
   int ind_cls_sort_mode; // value of this variable controls how assumptions 
                          // are sorted when looking for an inductive clause
   int gate_sort_mode; // value of this variable controls the ordering of
@@ -266,6 +273,7 @@ public:
   void form_constr_lits();
   void add_constrs();
   void print_aiger_format();
+  void extr_lemmas(CNF &H);
 
 protected:
 
@@ -277,6 +285,7 @@ protected:
   int num_gstate_cubes; // number of times a good state has been lifted
   float length_gstate_cubes; // number of length of the good state cubes
                              //  after lifting
+  int num_tern_lifts; // number of states lifted by ternary simulation
   long new_state_cnt; // counts the number of new states that appeared 
                       // in the obligation table
   long old_state_cnt; // counts the number of old states that appeared 
@@ -323,6 +332,17 @@ protected:
   NameTable Name_table; // Table with the names of Sat-solvers for
                         //  which 'init_sat_solver' were invoked
 
+ // ------------- ternary simulation (used in lifting states)
+
+  CUBE Tern_order; // combinational gates of N in topological order
+  CUBE Tern_pos; // Tern_pos[gate_ind] gives the position of gate 'gate_ind'
+                 // in 'Tern_order' (-1 for inputs and latches)
+  CCUBE Tern_vals; // Tern_vals[gate_ind] gives the value of the output of
+                   // gate 'gate_ind': 0, 1 or 2 (unknown)
+  CCUBE Tern_trg; // Tern_trg[gate_ind] is the value the output of gate
+                  // 'gate_ind' has to keep (2 if there is no such value)
+  CCUBE Tern_queued; // marks the gates queued for re-evaluation
+
  // ------------- init data
 
   CNF Tr; // transition relation
@@ -403,6 +423,7 @@ const char ROOT_STATE = 2;
 const char CTG_STATE = 3;
 const char PUSH_STATE = 4;
 const char UNKNOWN_STATE = 5;
+const char LEMMA_STATE = 6;
 
 // values of 'grl_heur'
 const int NO_JOINS = 0;
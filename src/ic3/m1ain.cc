@@ -14,8 +14,12 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 #include <ebmc/property_checker.h>
 #include <ebmc/report_results.h>
 
+#include <solvers/sat/satcheck.h>
+
 #include <trans-netlist/netlist.h>
 #include <trans-netlist/trans_to_netlist.h>
+#include <trans-netlist/trans_trace_netlist.h>
+#include <trans-netlist/unwind_netlist.h>
 
 #include <temporal-logic/temporal_expr.h>
 #include <temporal-logic/temporal_logic.h>
@@ -54,6 +58,7 @@ int do_ic3(const cmdlinet &cmdline,
   return(ic3_enginet(cmdline,ui_message_handler)());
 } /* end of function do_ic3 */
 
+
 bool ic3_supports_property(const exprt &expr)
 {
   if(!is_temporal_operator(expr))
@@ -74,6 +79,238 @@ bool ic3_supports_property(const exprt &expr)
     return false;
 }
 
+/*=====================================
+
+     I C 3 _ C H E C K _ P R O P E R T I E S
+
+  ====================================*/
+void ic3_check_properties(
+  const cmdlinet &cmdline,
+  const transition_systemt &transition_system,
+  ebmc_propertiest &properties,
+  message_handlert &message_handler)
+{
+  ic3_enginet(cmdline, message_handler)
+    .check_properties(transition_system, properties);
+} /* end of function ic3_check_properties */
+
+/*=====================================
+
+    C H E C K _ P R O P E R T Y
+
+   Checks the given property of an already
+   built netlist. The clauses of 'lemmas'
+   are given to IC3, which only uses the
+   inductive ones. The clauses IC3 learns
+   are added to 'lemmas'
+  ====================================*/
+int ic3_enginet::check_property(
+  const netlistt &_netlist,
+  const ebmc_propertiest &_properties,
+  const irep_idt &identifier,
+  LatchClauses &lemmas)
+{
+  Ci.init_parameters();
+  read_parameters();
+
+  select_property(_properties, identifier);
+
+  netlist = _netlist;
+
+  const0 = false;
+  const1 = false;
+  orig_names = false;
+
+  read_ebmc_input();
+  import_lemmas(lemmas);
+
+  int res = Ci.run_ic3();
+
+  export_lemmas(lemmas);
+  return(res);
+
+} /* end of function check_property */
+
+/*=====================================
+
+    S E L E C T _ P R O P E R T Y
+
+   Turns off all properties except the
+   given one
+  ====================================*/
+void ic3_enginet::select_property(
+  const ebmc_propertiest &_properties,
+  const irep_idt &identifier)
+{
+  properties = _properties;
+
+  for(auto &property : properties.properties)
+    if(property.identifier == identifier)
+    {
+      property.unknown();
+      Ci.prop_name = id2string(property.name);
+    }
+    else
+      property.disable();
+
+} /* end of function select_property */
+
+/*=====================================
+
+    W I T N E S S _ T R A C E
+
+   IC3 refuted the property with a
+   counterexample of 'length' states.
+   BMC on the netlist with the same
+   number of time frames gives the trace.
+   The netlist is used since designs
+   given as netlists have no word-level
+   transition relation
+  ====================================*/
+void ic3_enginet::witness_trace(
+  const namespacet &ns,
+  propertyt &property,
+  std::size_t length)
+{
+  auto netlist_property = netlist.properties.find(property.identifier);
+
+  if(length == 0 || netlist_property == netlist.properties.end())
+    return;
+
+  satcheckt solver{message.get_message_handler()};
+  const auto bmc_map = bmc_mapt{netlist, length, solver};
+
+  ::unwind(netlist, bmc_map, message, solver);
+
+  bvt timeframe_literals;
+  ::unwind_property(netlist_property->second, bmc_map, timeframe_literals);
+
+  // the properties that are assumed
+  for(const auto &p : properties.properties)
+  {
+    if(!p.is_assumed())
+      continue;
+
+    auto assumption = netlist.properties.find(p.identifier);
+
+    if(assumption != netlist.properties.end())
+    {
+      bvt assumption_literals;
+      ::unwind_property(assumption->second, bmc_map, assumption_literals);
+      for(auto l : assumption_literals)
+        solver.l_set_to(l, true);
+    }
+  }
+
+  solver.l_set_to(solver.land(timeframe_literals), false);
+
+  if(solver.prop_solve() == propt::resultt::P_SATISFIABLE)
+  {
+    property.witness_trace =
+      compute_trans_trace(timeframe_literals, bmc_map, solver, ns);
+  }
+
+} /* end of function witness_trace */
+
+/*=====================================
+
+    C H E C K _ P R O P E R T I E S
+
+   Checks the properties one after the
+   other. The netlist is built once, and
+   the clauses learned for a property are
+   offered to the next ones as lemmas.
+   Returns the value 'run_ic3' returns for
+   a single property: that of a failed
+   verification of a result, if any, then
+   1 if a property fails, 3 if one is
+   undecided and 2 if all of them hold
+  ====================================*/
+int ic3_enginet::check_properties(const transition_systemt &transition_system)
+{
+  LatchClauses lemmas;
+  const namespacet ns(transition_system.symbol_table);
+
+  int ret_val = 2;
+
+  // the order in which the return values of 'run_ic3' take precedence
+  auto rank = [](int res) {
+    return res >= 10 ? 3 : res == 1 ? 2 : res == 3 ? 1 : 0;
+  };
+
+  for(auto &property : properties.properties)
+  {
+    if(!property.is_unknown())
+      continue;
+
+    message.status() << "Checking " << property.name << messaget::eom;
+
+    // every run of IC3 needs its own CompInfo
+    ic3_enginet engine(cmdline, message.get_message_handler());
+
+    int res =
+      engine.check_property(netlist, properties, property.identifier, lemmas);
+
+    // see CompInfo::run_ic3 for the return values
+    if(res == 2)
+      property.proved();
+    else if(res == 1)
+    {
+      property.refuted();
+      witness_trace(ns, property, engine.Ci.Cex.size());
+    }
+    else if(res == 3)
+      property.inconclusive();
+    else
+      property.failure("IC3 failed to confirm its result");
+
+    if(rank(res) > rank(ret_val))
+      ret_val = res;
+  }
+
+  return(ret_val);
+
+} /* end of function check_properties */
+
+/*=====================================
+
+    C H E C K _ P R O P E R T I E S
+
+   Checks the given properties of a
+   transition system, and updates their
+   status. Returns what the function
+   above returns
+  ====================================*/
+int ic3_enginet::check_properties(
+  const transition_systemt &transition_system,
+  ebmc_propertiest &_properties)
+{
+  properties = _properties;
+
+  convert_to_netlist(
+    cmdline,
+    transition_system,
+    properties.make_property_map(),
+    netlist,
+    message.get_message_handler());
+
+  for(auto &property : properties.properties)
+  {
+    if(
+      property.is_unknown() &&
+      !ic3_supports_property(property.normalized_expr))
+    {
+      property.failure("property not supported by IC3 engine");
+    }
+  }
+
+  int ret_val = check_properties(transition_system);
+
+  _properties = properties;
+  return(ret_val);
+
+} /* end of function check_properties */
+
 /*==================================
 
     O P E R A T O R
@@ -98,9 +335,9 @@ int ic3_enginet::operator()()
     // make net-list
     message.status() << "Generating Netlist" << messaget::eom;
 
-    convert_trans_to_netlist(
-      transition_system.symbol_table,
-      transition_system.main_symbol->name,
+    convert_to_netlist(
+      cmdline,
+      transition_system,
       properties.make_property_map(),
       netlist,
       message.get_message_handler());
@@ -139,6 +376,16 @@ int ic3_enginet::operator()()
       report_results(cmdline, result, ns, message.get_message_handler());
       return result.exit_code();
     }
+
+    // --aiger writes the circuit for a single property
+    if(number_of_properties >= 2 && !cmdline.isset("aiger"))
+    {
+      int ret_val = check_properties(transition_system);
+      namespacet ns(transition_system.symbol_table);
+      property_checker_resultt result{properties};
+      report_results(cmdline, result, ns, message.get_message_handler());
+      return(ret_val);
+    }
   }
   catch(const std::string &error_str)
   {
@@ -279,6 +526,8 @@ int CompInfo::mic3()
 
   if (ctg_flag) form_coi_array();
   tf_lind = 1;
+
+  if (Lemmas.size() > 0) add_lemmas();
  
 
   init_lbs_sat_solver();
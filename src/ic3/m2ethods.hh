@@ -148,6 +148,17 @@ bool triv_ind_cls_proc(CLAUSE &Res,CLAUSE &C,int tf_ind);
 bool adjust_clause2(CLAUSE &C,CUBE &St,SCUBE &Failed_lits);
 int pick_lit_to_remove(CLAUSE &Curr,SCUBE &Tried,int curr_tf);
 void lift_ctg_state(CUBE &Ctg_cube,CUBE &Ctg_st,CUBE &Inps,CUBE &Nxt_st);
+//
+//  lifting states by ternary simulation
+bool tern_lift_applies();
+void form_tern_gate_order();
+char tern_gate_val(Gate &G);
+bool tern_set_unknown(int gate_ind);
+bool tern_lift(CUBE &St_cube,CUBE &St,CUBE &Inps,CUBE &Trg);
+//
+//  reusing the clauses learned for other properties
+void filter_lemmas();
+void add_lemmas();
 void form_coi_array();
 void form_coi(CUBE &Coi,CUBE &Stack,hsh_tbl &Htbl);
 void conv_gates_to_svars(DNF &Coi_arr);
@@ -86,6 +86,7 @@ void CompInfo::init_parameters()
   act_upd_mode = MINISAT_ACT_UPD;
   sorted_objects = VARS;
   lift_sort_mode = FULL_SORT;
+  ternary_lift = true;
   ind_cls_sort_mode = FULL_SORT;
   gate_sort_mode = INPS_FIRST;
   multiplier = 1.05;
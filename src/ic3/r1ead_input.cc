@@ -183,6 +183,7 @@ void ic3_enginet::add_new_latch(NamesOfLatches &Latches, int init_val,
   N->nlatches++;
   N->Latches.push_back(pin_num); // add one more latch to the list of latches
   int gate_ind = pin_num;
+  Latch_gates[pres_lit.var_no()] = gate_ind;
 
   CCUBE Next_name;
 
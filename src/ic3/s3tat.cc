@@ -25,6 +25,8 @@ Author: Eugene Goldberg, eu.goldberg@gmail.com
 void CompInfo::print_lifting_stat()
 {
 
+  printf("#states lifted by ternary simulation = %d\n",num_tern_lifts);
+
   if (num_bstate_cubes == 0) return;
   if (num_gstate_cubes == 0) return;
 
@@ -0,0 +1,204 @@
+/*******************************************************************\
+
+Module: Jobs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+#include "jobs.h"
+
+#include <util/exception_utils.h>
+#include <util/irep_serialization.h>
+
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+#  include <sys/wait.h>
+#  include <csignal>
+#  include <cstdio>
+#  include <unistd.h>
+#endif
+
+#ifndef _WIN32
+
+/*******************************************************************\
+
+Function: write_all
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void write_all(int fd, const std::string &data)
+{
+  const char *p = data.data();
+  std::size_t remaining = data.size();
+
+  while(remaining != 0)
+  {
+    auto written = write(fd, p, remaining);
+    if(written <= 0)
+      return;
+    p += written;
+    remaining -= written;
+  }
+}
+
+/*******************************************************************\
+
+Function: read_all
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::string read_all(int fd)
+{
+  std::string result;
+  char buffer[4096];
+
+  while(true)
+  {
+    auto r = read(fd, buffer, sizeof(buffer));
+    if(r <= 0)
+      break;
+    result.append(buffer, r);
+  }
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: fork_job
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+// Set in the jobs. The jobs that are forked by a job stay in its
+// process group, and are hence terminated with it.
+static bool in_job = false;
+
+ebmc_jobt fork_job(const std::function<irept()> &function)
+{
+  // don't duplicate any buffered output in the job
+  std::cout.flush();
+  std::cerr.flush();
+  fflush(stdout);
+
+  int fds[2];
+  if(pipe(fds) != 0)
+    throw system_exceptiont("failed to create pipe for job");
+
+  pid_t pid = fork();
+
+  if(pid == -1)
+    throw system_exceptiont("failed to fork job");
+
+  if(pid == 0)
+  {
+    // We are the job. Unless we are nested in another job, use a
+    // process group, such that any processes we fork get terminated
+    // with us.
+    if(!in_job)
+      setpgid(0, 0);
+
+    in_job = true;
+    close(fds[0]);
+
+    int exit_code = 0;
+
+    try
+    {
+      irept result = function();
+      std::ostringstream out;
+      irep_serializationt::ireps_containert ireps_container;
+      irep_serializationt{ireps_container}.reference_convert(result, out);
+      write_all(fds[1], out.str());
+    }
+    catch(...)
+    {
+      exit_code = 1;
+    }
+
+    close(fds[1]);
+    _exit(exit_code);
+  }
+
+  if(!in_job)
+    setpgid(pid, pid);
+
+  close(fds[1]);
+
+  return ebmc_jobt{pid, fds[0]};
+}
+
+/*******************************************************************\
+
+Function: wait_job
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+irept wait_job(const ebmc_jobt &job)
+{
+  std::istringstream in(read_all(job.fd));
+  close(job.fd);
+
+  int status;
+  waitpid(job.pid, &status, 0);
+
+  if(WIFEXITED(status) && WEXITSTATUS(status) == 0)
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    return irep_serializationt{ireps_container}.reference_convert(in);
+  }
+  else
+    return irept{ID_nil};
+}
+
+/*******************************************************************\
+
+Function: kill_job
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void kill_job(const ebmc_jobt &job)
+{
+  // a nested job shares the process group of the enclosing job
+  if(in_job)
+    kill(job.pid, SIGKILL);
+  else
+    kill(-job.pid, SIGKILL);
+
+  close(job.fd);
+  waitpid(job.pid, nullptr, 0);
+}
+
+#endif
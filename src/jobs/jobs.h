@@ -0,0 +1,46 @@
+/*******************************************************************\
+
+Module: Jobs
+
+Author: Daniel Kroening, dkr@amazon.com
+
+\*******************************************************************/
+
+/// \file
+/// Jobs, i.e., processes forked to run a function concurrently.
+/// Shared by ebmc and vlindex.
+
+#ifndef CPROVER_JOBS_H
+#define CPROVER_JOBS_H
+
+#include <util/irep.h>
+
+#include <functional>
+
+#ifndef _WIN32
+/// A process that has been forked from the current process,
+/// which sends a single irep back through a pipe.
+/// The irep data structures are not thread-safe, and thus,
+/// we use processes for running engines concurrently.
+struct ebmc_jobt
+{
+  int pid;
+  int fd;
+};
+
+/// Forks a process that runs the given function,
+/// and sends the result back to the caller.
+/// A job forked by the top-level process gets its own process group,
+/// and the jobs it forks in turn stay in that group.
+/// Throws system_exceptiont if the job cannot be started.
+ebmc_jobt fork_job(const std::function<irept()> &);
+
+/// Waits for the given job to terminate, and returns its result,
+/// or a nil irep if the job did not complete.
+irept wait_job(const ebmc_jobt &);
+
+/// Terminates the given job, including any processes it has forked.
+void kill_job(const ebmc_jobt &);
+#endif
+
+#endif // CPROVER_JOBS_H
@@ -0,0 +1,848 @@
+/*******************************************************************\
+
+Module: AIG Optimization for Netlists
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "aig_opt.h"
+
+#include <util/ebmc_util.h>
+#include <util/invariant.h>
+
+#include <solvers/sat/satcheck.h>
+
+#include "netlist_coi.h"
+#include "netlist_simulator.h"
+
+#include <algorithm>
+#include <map>
+#include <queue>
+#include <random>
+#include <unordered_map>
+
+/// Rebuilds the AND nodes of a netlist, in the order in which they are
+/// needed by the variables, the constraints and the properties.
+/// A node is replaced by the literal given in \p equivalent, unless
+/// that literal is the node itself. The variable nodes are all kept.
+class aig_rebuildt
+{
+public:
+  aig_rebuildt(
+    const netlistt &_src,
+    const std::vector<literalt> &_equivalent,
+    bool _balance)
+    : src(_src), equivalent(_equivalent), balance(_balance)
+  {
+    build();
+  }
+
+  netlistt netlist;
+
+protected:
+  const netlistt &src;
+  const std::vector<literalt> &equivalent;
+  bool balance;
+
+  // maps the nodes of 'src' to the literals in 'netlist'
+  std::vector<literalt> node_map;
+  std::vector<bool> is_mapped;
+
+  // the variable nodes in 'netlist', including the replaced ones
+  std::vector<literalt> var_node_map;
+
+  // the number of uses of the nodes of 'src'
+  std::vector<std::size_t> fanout;
+
+  // the depth of the nodes of 'netlist'
+  std::vector<std::size_t> level;
+
+  struct key_hasht
+  {
+    std::size_t operator()(const std::pair<unsigned, unsigned> &key) const
+    {
+      return std::hash<unsigned>()(key.first) * 31 + key.second;
+    }
+  };
+
+  // structural hashing
+  std::unordered_map<std::pair<unsigned, unsigned>, literalt, key_hasht>
+    and_nodes;
+
+  void build();
+  void count_fanout();
+  literalt translate(literalt);
+  literalt translate_var(literalt);
+  literalt mapped(literalt) const;
+  void supergate(std::size_t node, bvt &leaves) const;
+  literalt balanced_and(bvt leaves);
+  literalt land(literalt, literalt);
+  literalt new_and_node(literalt, literalt);
+
+  bool is_and(literalt l) const
+  {
+    return !l.is_constant() && netlist.get_node(l).is_and();
+  }
+
+  std::size_t get_level(literalt l) const
+  {
+    return l.is_constant() ? 0 : level[l.var_no()];
+  }
+
+  bool is_replaced(std::size_t n) const
+  {
+    return equivalent[n] != literalt(n, false);
+  }
+};
+
+/*******************************************************************\
+
+Function: aig_rebuildt::count_fanout
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aig_rebuildt::count_fanout()
+{
+  fanout.resize(src.number_of_nodes(), 0);
+
+  auto use = [this](literalt l)
+  {
+    if(!l.is_constant())
+      fanout[l.var_no()]++;
+  };
+
+  for(const auto &node : src.nodes)
+  {
+    if(node.is_and())
+    {
+      use(node.a);
+      use(node.b);
+    }
+  }
+
+  // the uses outside of the AIG
+  for(const auto &[_, var] : src.var_map.map)
+  {
+    for(const auto &bit : var.bits)
+    {
+      use(bit.current);
+      if(var.is_latch())
+        use(bit.next);
+    }
+  }
+
+  for(auto l : src.initial)
+    use(l);
+
+  for(auto l : src.constraints)
+    use(l);
+
+  for(auto l : src.transition)
+    use(l);
+
+  for(const auto &[_, property] : src.properties)
+    for(auto l : netlist_property_literals(property))
+      use(l);
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::new_and_node
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: structural hashing
+
+\*******************************************************************/
+
+literalt aig_rebuildt::new_and_node(literalt a, literalt b)
+{
+  if(b < a)
+    std::swap(a, b);
+
+  auto key = std::make_pair(a.get(), b.get());
+  auto node_it = and_nodes.find(key);
+
+  if(node_it != and_nodes.end())
+    return node_it->second;
+
+  literalt l = netlist.new_and_node(a, b);
+  level.push_back(std::max(get_level(a), get_level(b)) + 1);
+  and_nodes.emplace(key, l);
+
+  return l;
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::land
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a new AND node, simplified using the one-level and
+          two-level rules
+
+\*******************************************************************/
+
+literalt aig_rebuildt::land(literalt a, literalt b)
+{
+  if(a.is_false() || b.is_false())
+    return const_literal(false);
+
+  if(a.is_true())
+    return b;
+
+  if(b.is_true())
+    return a;
+
+  if(a == b)
+    return a;
+
+  if(a == !b)
+    return const_literal(false);
+
+  for(std::size_t i = 0; i < 2; i++)
+  {
+    if(is_and(a))
+    {
+      // a copy, as new nodes may be added below
+      const aig_nodet node = netlist.get_node(a);
+
+      if(!a.sign())
+      {
+        // (x & y) & x = x & y
+        if(b == node.a || b == node.b)
+          return a;
+
+        // (x & y) & !x = 0
+        if(b == !node.a || b == !node.b)
+          return const_literal(false);
+      }
+      else
+      {
+        // !(x & y) & !x = !x
+        if(b == !node.a || b == !node.b)
+          return b;
+
+        // !(x & y) & x = x & !y
+        if(b == node.a)
+          return land(b, !node.b);
+
+        if(b == node.b)
+          return land(b, !node.a);
+      }
+    }
+
+    std::swap(a, b);
+  }
+
+  if(is_and(a) && is_and(b) && !a.sign() && !b.sign())
+  {
+    const aig_nodet node_a = netlist.get_node(a);
+    const aig_nodet node_b = netlist.get_node(b);
+
+    // (x & y) & (!x & z) = 0
+    if(
+      node_a.a == !node_b.a || node_a.a == !node_b.b ||
+      node_a.b == !node_b.a || node_a.b == !node_b.b)
+    {
+      return const_literal(false);
+    }
+  }
+
+  return new_and_node(a, b);
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::supergate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the inputs of the tree of AND nodes rooted in the given
+          node, where the tree only includes nodes that have no
+          other uses
+
+\*******************************************************************/
+
+void aig_rebuildt::supergate(std::size_t n, bvt &leaves) const
+{
+  leaves.clear();
+
+  const auto &root = src.nodes[n];
+
+  if(!balance)
+  {
+    leaves.push_back(root.a);
+    leaves.push_back(root.b);
+    return;
+  }
+
+  bvt todo = {root.b, root.a};
+
+  while(!todo.empty())
+  {
+    literalt l = todo.back();
+    todo.pop_back();
+
+    if(
+      !l.is_constant() && !l.sign() && src.get_node(l).is_and() &&
+      fanout[l.var_no()] == 1 && !is_replaced(l.var_no()))
+    {
+      todo.push_back(src.get_node(l).b);
+      todo.push_back(src.get_node(l).a);
+    }
+    else
+      leaves.push_back(l);
+  }
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::balanced_and
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the conjunction of the given literals of the new netlist,
+          combining the literals with the least depth first
+
+\*******************************************************************/
+
+literalt aig_rebuildt::balanced_and(bvt leaves)
+{
+  std::sort(leaves.begin(), leaves.end());
+  leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+  // x and !x are adjacent after sorting
+  for(std::size_t i = 1; i < leaves.size(); i++)
+    if(leaves[i] == !leaves[i - 1])
+      return const_literal(false);
+
+  using entryt = std::pair<std::size_t, literalt>;
+
+  auto greater = [](const entryt &a, const entryt &b)
+  { return a.first > b.first || (a.first == b.first && b.second < a.second); };
+
+  std::priority_queue<entryt, std::vector<entryt>, decltype(greater)> queue(
+    greater);
+
+  for(auto l : leaves)
+    queue.emplace(get_level(l), l);
+
+  if(queue.empty())
+    return const_literal(true);
+
+  while(queue.size() > 1)
+  {
+    literalt a = queue.top().second;
+    queue.pop();
+    literalt b = queue.top().second;
+    queue.pop();
+    literalt l = land(a, b);
+    queue.emplace(get_level(l), l);
+  }
+
+  return queue.top().second;
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::mapped
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+literalt aig_rebuildt::mapped(literalt l) const
+{
+  if(l.is_constant())
+    return l;
+
+  PRECONDITION(is_mapped[l.var_no()]);
+
+  return node_map[l.var_no()] ^ l.sign();
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::translate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: translates a literal of the given netlist into a literal
+          of the new netlist, building the nodes that are needed
+
+\*******************************************************************/
+
+literalt aig_rebuildt::translate(literalt l)
+{
+  if(l.is_constant())
+    return l;
+
+  // The AIGs can be deep, and hence, no recursion.
+  std::vector<std::size_t> stack = {l.var_no()};
+  bvt leaves;
+
+  while(!stack.empty())
+  {
+    std::size_t n = stack.back();
+
+    if(is_mapped[n])
+    {
+      stack.pop_back();
+      continue;
+    }
+
+    if(is_replaced(n))
+    {
+      literalt e = equivalent[n];
+
+      if(e.is_constant() || is_mapped[e.var_no()])
+      {
+        node_map[n] = mapped(e);
+        is_mapped[n] = true;
+        stack.pop_back();
+      }
+      else
+        stack.push_back(e.var_no());
+
+      continue;
+    }
+
+    // the variable nodes that are kept are mapped up front
+    DATA_INVARIANT(src.nodes[n].is_and(), "expected AND node");
+
+    supergate(n, leaves);
+
+    bool ready = true;
+
+    for(auto leaf : leaves)
+    {
+      if(!leaf.is_constant() && !is_mapped[leaf.var_no()])
+      {
+        stack.push_back(leaf.var_no());
+        ready = false;
+      }
+    }
+
+    if(ready)
+    {
+      for(auto &leaf : leaves)
+        leaf = mapped(leaf);
+
+      node_map[n] = balanced_and(leaves);
+      is_mapped[n] = true;
+      stack.pop_back();
+    }
+  }
+
+  return mapped(l);
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::translate_var
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: translates the current-state literal of a latch, input
+          or nondet, which keeps its variable node even if replaced
+
+\*******************************************************************/
+
+literalt aig_rebuildt::translate_var(literalt l)
+{
+  if(!l.is_constant() && src.get_node(l).is_var())
+    return var_node_map[l.var_no()] ^ l.sign();
+  else
+    return translate(l);
+}
+
+/*******************************************************************\
+
+Function: aig_rebuildt::build
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void aig_rebuildt::build()
+{
+  PRECONDITION(equivalent.size() == src.number_of_nodes());
+
+  node_map.resize(src.number_of_nodes(), const_literal(false));
+  is_mapped.resize(src.number_of_nodes(), false);
+
+  count_fanout();
+
+  // Keep all variable nodes, in their original order. The uses of
+  // the replaced ones are translated into their replacement.
+  var_node_map.resize(src.number_of_nodes(), const_literal(false));
+
+  for(std::size_t n = 0; n < src.number_of_nodes(); n++)
+  {
+    if(src.nodes[n].is_var())
+    {
+      var_node_map[n] = netlist.new_var_node();
+      level.push_back(0);
+
+      if(!is_replaced(n))
+      {
+        node_map[n] = var_node_map[n];
+        is_mapped[n] = true;
+      }
+    }
+  }
+
+  // the variables
+  for(const auto &[id, var] : src.var_map.map)
+  {
+    auto &new_var = netlist.var_map.map[id];
+    new_var = var;
+
+    const bool has_var_nodes =
+      var.is_latch() || var.is_input() || var.is_nondet();
+
+    for(auto &bit : new_var.bits)
+    {
+      if(has_var_nodes)
+        bit.current = translate_var(bit.current);
+      else
+        bit.current = translate(bit.current);
+
+      if(var.is_latch())
+        bit.next = translate(bit.next);
+      else
+        bit.next = const_literal(false);
+    }
+  }
+
+  netlist.var_map.build_reverse_map();
+
+  // The reverse map for the other variable nodes, i.e., for the
+  // nondets and for the variable nodes that are replaced.
+  for(const auto &[id, var] : src.var_map.map)
+  {
+    for(std::size_t bit_nr = 0; bit_nr < var.bits.size(); bit_nr++)
+    {
+      literalt l = var.bits[bit_nr].current;
+
+      if(l.is_constant() || !src.get_node(l).is_var())
+        continue;
+
+      auto node = var_node_map[l.var_no()].var_no();
+
+      if(netlist.var_map.reverse_map.count(node) == 0)
+      {
+        auto &reverse = netlist.var_map.reverse_map[node];
+        reverse.id = id;
+        reverse.bit_nr = bit_nr;
+      }
+    }
+  }
+
+  // constraints
+  for(auto l : src.initial)
+    netlist.initial.push_back(translate(l));
+
+  // The replaced variable nodes that are kept are equal to their
+  // replacement in the initial states, as the uses of the nodes in
+  // the initial-state constraints are replaced.
+  for(std::size_t n = 0; n < src.number_of_nodes(); n++)
+  {
+    if(src.nodes[n].is_var() && is_replaced(n))
+    {
+      literalt a = var_node_map[n];
+      literalt b = translate(literalt(n, false));
+      netlist.initial.push_back(land(!land(a, !b), !land(!a, b)));
+    }
+  }
+
+  for(auto l : src.constraints)
+    netlist.constraints.push_back(translate(l));
+
+  for(auto l : src.transition)
+    netlist.transition.push_back(translate(l));
+
+  // properties
+  for(const auto &[id, property] : src.properties)
+  {
+    if(std::holds_alternative<netlistt::Gpt>(property))
+    {
+      netlist.properties.emplace(
+        id, netlistt::Gpt{translate(std::get<netlistt::Gpt>(property).p)});
+    }
+    else
+    {
+      netlist.properties.emplace(
+        id, netlistt::GFpt{translate(std::get<netlistt::GFpt>(property).p)});
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: no_equivalences
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::vector<literalt> no_equivalences(const netlistt &netlist)
+{
+  std::vector<literalt> result;
+  result.reserve(netlist.number_of_nodes());
+
+  for(std::size_t n = 0; n < netlist.number_of_nodes(); n++)
+    result.push_back(literalt(n, false));
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: sat_sweep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: for each node, the literal of an earlier node or the
+          constant that the node is equivalent to, or the node itself
+
+\*******************************************************************/
+
+static std::vector<literalt>
+sat_sweep(const netlistt &netlist, message_handlert &message_handler)
+{
+  using wordt = netlist_simulatort::wordt;
+
+  const std::size_t nodes = netlist.number_of_nodes();
+  std::vector<literalt> equivalent = no_equivalences(netlist);
+
+  // The signature of a node is its value in a number of rounds of
+  // simulation with random values for the variable nodes.
+  const std::size_t rounds = 4;
+  std::vector<std::vector<wordt>> signatures(nodes);
+
+  netlist_simulatort simulator(netlist);
+  std::mt19937_64 random; // deterministic
+
+  for(std::size_t round = 0; round < rounds; round++)
+  {
+    for(std::size_t n = 0; n < nodes; n++)
+      if(netlist.nodes[n].is_var())
+        simulator.set(literalt(n, false), random());
+
+    simulator.evaluate();
+
+    for(std::size_t n = 0; n < nodes; n++)
+      signatures[n].push_back(simulator.get(literalt(n, false)));
+  }
+
+  // Normalize the signatures such that the first run is zero, to
+  // find the nodes that are equivalent up to negation.
+  std::vector<bool> phase(nodes, false);
+
+  for(std::size_t n = 0; n < nodes; n++)
+  {
+    if(signatures[n].front() & 1)
+    {
+      phase[n] = true;
+      for(auto &word : signatures[n])
+        word = ~word;
+    }
+  }
+
+  // the candidate classes, with the nodes in topological order
+  std::map<std::vector<wordt>, std::vector<std::size_t>> classes;
+
+  for(std::size_t n = 0; n < nodes; n++)
+    classes[signatures[n]].push_back(n);
+
+  signatures.clear();
+
+  // the AIG as CNF
+  satcheckt solver{message_handler};
+  bvt sat_literals;
+  sat_literals.reserve(nodes);
+
+  auto sat_literal = [&sat_literals](literalt l)
+  { return l.is_constant() ? l : sat_literals[l.var_no()] ^ l.sign(); };
+
+  for(std::size_t n = 0; n < nodes; n++)
+  {
+    const auto &node = netlist.nodes[n];
+    literalt l = solver.new_variable();
+    sat_literals.push_back(l);
+
+    if(node.is_and())
+      cnf_gate_and(solver, sat_literal(node.a), sat_literal(node.b), l);
+  }
+
+  // whether the given assumptions are unsatisfiable
+  auto unsat = [&solver](const bvt &assumptions)
+  {
+    solver.set_assumptions(assumptions);
+    return solver.prop_solve() == propt::resultt::P_UNSATISFIABLE;
+  };
+
+  // Compare with a few representatives only, to limit the
+  // number of calls to the solver.
+  const std::size_t max_representatives = 4;
+
+  const std::vector<wordt> zero(rounds, 0);
+
+  for(const auto &[signature, members] : classes)
+  {
+    const bool is_constant_class = signature == zero;
+    std::vector<std::size_t> representatives;
+
+    for(auto n : members)
+    {
+      const bool is_var = netlist.nodes[n].is_var();
+
+      if(!is_var)
+      {
+        // the normalized node is always false?
+        if(
+          is_constant_class &&
+          unsat({sat_literal(literalt(n, false)) ^ phase[n]}))
+        {
+          equivalent[n] = const_literal(phase[n]);
+          continue;
+        }
+
+        bool merged = false;
+
+        for(auto r : representatives)
+        {
+          literalt candidate = literalt(r, phase[n] != phase[r]);
+          literalt l_n = sat_literal(literalt(n, false));
+          literalt l_r = sat_literal(candidate);
+
+          if(unsat({l_n, !l_r}) && unsat({!l_n, l_r}))
+          {
+            equivalent[n] = candidate;
+            merged = true;
+            break;
+          }
+        }
+
+        if(merged)
+          continue;
+      }
+
+      if(representatives.size() < max_representatives)
+        representatives.push_back(n);
+    }
+  }
+
+  return equivalent;
+}
+
+/*******************************************************************\
+
+Function: substitute_nodes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlistt substitute_nodes(
+  const netlistt &src,
+  const std::vector<literalt> &equivalent)
+{
+  return aig_rebuildt{src, equivalent, false}.netlist;
+}
+
+/*******************************************************************\
+
+Function: number_of_and_nodes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static std::size_t number_of_and_nodes(const netlistt &netlist)
+{
+  std::size_t result = 0;
+
+  for(const auto &node : netlist.nodes)
+    if(node.is_and())
+      result++;
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: aig_opt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlistt aig_opt(const netlistt &src, message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
+  // rewriting and balancing
+  const auto identity = no_equivalences(src);
+  netlistt balanced = aig_rebuildt{src, identity, true}.netlist;
+
+  // SAT sweeping
+  const auto equivalent = sat_sweep(balanced, message_handler);
+  netlistt result = substitute_nodes(balanced, equivalent);
+
+  message.status() << "AIG optimization: " << number_of_and_nodes(src)
+                   << " AND nodes before, " << number_of_and_nodes(balanced)
+                   << " after rewriting and balancing, "
+                   << number_of_and_nodes(result) << " after SAT sweeping"
+                   << messaget::eom;
+
+  return result;
+}
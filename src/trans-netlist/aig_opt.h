@@ -0,0 +1,45 @@
+/*******************************************************************\
+
+Module: AIG Optimization for Netlists
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// AIG Optimization for Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_AIG_OPT_H
+#define CPROVER_TRANS_NETLIST_AIG_OPT_H
+
+#include "netlist.h"
+
+class message_handlert;
+
+/// Optimizes the AND nodes of a netlist, and returns the new netlist.
+/// The variable nodes, the var_map, the constraints and the
+/// properties are kept, with their literals translated.
+/// There are three passes:
+/// 1. The AIG is rebuilt with structural hashing, constant
+///    propagation, and rewriting with the two-level AND rules.
+/// 2. Trees of AND nodes without further fan-out are balanced,
+///    to reduce the depth of the AIG.
+/// 3. SAT sweeping (fraiging): nodes that have the same values, up to
+///    negation, on bit-parallel random simulation are candidates for
+///    merging, and are merged when a SAT solver confirms that they are
+///    equivalent. The variable nodes, including the latches, are
+///    unconstrained, and thus, the merged nodes are equivalent in
+///    any state.
+netlistt aig_opt(const netlistt &, message_handlert &);
+
+/// Rebuilds the given netlist with each node n replaced by
+/// \p equivalent[n], unless that is the node itself. A replacement is
+/// a constant, the literal of an earlier node, or, for variable nodes,
+/// the literal of another variable node. The variable nodes are kept,
+/// and the latches, inputs and nondets in the var_map keep referring
+/// to their own nodes, but all other uses are replaced. The initial
+/// states constrain a replaced variable node to its replacement.
+netlistt
+substitute_nodes(const netlistt &, const std::vector<literalt> &equivalent);
+
+#endif // CPROVER_TRANS_NETLIST_AIG_OPT_H
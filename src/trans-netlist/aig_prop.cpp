@@ -8,6 +8,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include "aig_prop.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <set>
 #include <stack>
 
@@ -61,7 +63,73 @@ literalt aig_prop_baset::land(literalt a, literalt b) {
   if (a == b)
     return a;
 
-  return dest.new_and_node(a, b);
+  return strash_and(a, b);
+}
+
+std::size_t aig_prop_baset::strash_hash(literalt a, literalt b) const {
+  std::uint64_t key =
+      (std::uint64_t(a.get()) << 32) | std::uint64_t(b.get());
+  key *= 0x9e3779b97f4a7c15ull;
+  return std::size_t(key >> 32) & (strash_table.size() - 1);
+}
+
+void aig_prop_baset::strash_insert(literalt::var_not node_nr) {
+  const aig_nodet &node = dest.nodes[node_nr];
+  std::size_t slot = strash_hash(node.a, node.b);
+
+  while (strash_table[slot] != literalt::unused_var_no())
+    slot = (slot + 1) & (strash_table.size() - 1);
+
+  strash_table[slot] = node_nr;
+  strash_entries++;
+}
+
+void aig_prop_baset::strash_grow() {
+  std::vector<literalt::var_not> old_table;
+  old_table.swap(strash_table);
+
+  strash_table.resize(std::max(std::size_t(1024), old_table.size() * 2),
+                      literalt::unused_var_no());
+  strash_entries = 0;
+
+  for (auto node_nr : old_table) {
+    // The AIG might have been modified or cleared by others.
+    if (node_nr != literalt::unused_var_no() &&
+        node_nr < dest.number_of_nodes() && dest.nodes[node_nr].is_and())
+      strash_insert(node_nr);
+  }
+}
+
+literalt aig_prop_baset::strash_and(literalt a, literalt b) {
+  // AND is commutative; normalize the order of the inputs
+  if (b.get() < a.get())
+    std::swap(a, b);
+
+  // keep the load factor below 1/2
+  if (2 * (strash_entries + 1) > strash_table.size())
+    strash_grow();
+
+  std::size_t slot = strash_hash(a, b);
+
+  while (strash_table[slot] != literalt::unused_var_no()) {
+    auto node_nr = strash_table[slot];
+
+    if (node_nr < dest.number_of_nodes()) {
+      const aig_nodet &node = dest.nodes[node_nr];
+      if (node.is_and() && node.a == a && node.b == b) {
+        literalt l;
+        l.set(node_nr, false);
+        return l;
+      }
+    }
+
+    slot = (slot + 1) & (strash_table.size() - 1);
+  }
+
+  literalt l = dest.new_and_node(a, b);
+  strash_table[slot] = l.var_no();
+  strash_entries++;
+  return l;
 }
 
 literalt aig_prop_baset::lor(literalt a, literalt b) {
@@ -66,6 +66,18 @@ public:
 
 protected:
   aigt &dest;
+
+  // Structural hashing, to avoid creating AND nodes that already exist.
+  // This is an open-addressing hash table with linear probing, which
+  // stores the node numbers only; the keys are the inputs of the
+  // nodes in 'dest'. Empty slots are marked with unused_var_no().
+  std::vector<literalt::var_not> strash_table;
+  std::size_t strash_entries = 0;
+
+  literalt strash_and(literalt a, literalt b);
+  void strash_insert(literalt::var_not);
+  void strash_grow();
+  std::size_t strash_hash(literalt a, literalt b) const;
 };
 
 class aig_prop_constraintt : public aig_prop_baset {
@@ -37,8 +37,36 @@ bmc_mapt::bmc_mapt(
     timeframet &timeframe=timeframe_map[t];
     timeframe.resize(netlist.number_of_nodes());
 
+    // The latches in timeframe t take the values of the next-state
+    // functions in timeframe t-1, and hence, we use the same solver
+    // literals, instead of new variables and equalities.
+    std::vector<bool> is_latch_input(timeframe.size(), false);
+
+    if(t != 0)
+    {
+      for(const auto &[_, var] : netlist.var_map.map)
+      {
+        if(!var.is_latch())
+          continue;
+
+        for(const auto &bit : var.bits)
+        {
+          if(bit.current.is_constant())
+            continue;
+
+          auto n = bit.current.var_no();
+          timeframe[n].solver_literal =
+            translate(t - 1, bit.next) ^ bit.current.sign();
+          is_latch_input[n] = true;
+        }
+      }
+    }
+
     for(std::size_t n = 0; n < timeframe.size(); n++)
     {
+      if(is_latch_input[n])
+        continue;
+
       literalt solver_literal=solver.new_variable();
       timeframe[n].solver_literal=solver_literal;
 
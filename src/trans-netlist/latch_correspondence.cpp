@@ -0,0 +1,473 @@
+/*******************************************************************\
+
+Module: Latch Correspondence for Netlists
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "latch_correspondence.h"
+
+#include <util/message.h>
+
+#include <solvers/sat/satcheck.h>
+
+#include "aig_opt.h"
+#include "bmc_map.h"
+#include "netlist_simulator.h"
+#include "ternary_simulator.h"
+#include "unwind_netlist.h"
+
+#include <map>
+#include <optional>
+#include <random>
+
+/// Computes the classes of latches that are equivalent, up to
+/// negation, in all reachable states, and the latches that are
+/// constant.
+class latch_correspondencet
+{
+public:
+  latch_correspondencet(
+    const netlistt &_netlist,
+    message_handlert &_message_handler)
+    : netlist(_netlist), message_handler(_message_handler)
+  {
+  }
+
+  /// the replacement for each node, as expected by substitute_nodes
+  std::vector<literalt> operator()();
+
+  std::size_t number_of_ternary_constants() const
+  {
+    return ternary_constants.size();
+  }
+
+protected:
+  const netlistt &netlist;
+  message_handlert &message_handler;
+
+  // A candidate is the current-state node of a latch bit, with the
+  // phase that makes its value in the first simulation run false.
+  struct candidatet
+  {
+    std::size_t node;
+    bool phase;
+
+    literalt literal() const
+    {
+      return literalt(node, phase);
+    }
+  };
+
+  // The candidates in a class have the same value, and the first one
+  // is the representative.
+  using classt = std::vector<candidatet>;
+  std::vector<classt> classes;
+
+  // the candidates that are false
+  classt constants;
+
+  // the latches that are constant by ternary simulation, which
+  // need no further check
+  std::map<std::size_t, bool> ternary_constants;
+
+  std::vector<std::size_t> latch_nodes() const;
+  std::optional<std::vector<bool>>
+  initial_state(const std::vector<std::size_t> &latch_nodes);
+  void simulate(
+    const std::vector<std::size_t> &latch_nodes,
+    const std::vector<bool> &initial_state);
+  bool refine(bool base_case);
+};
+
+/*******************************************************************\
+
+Function: latch_correspondencet::latch_nodes
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the variable nodes of the latch bits that are not known
+          to be constant, in increasing order
+
+\*******************************************************************/
+
+std::vector<std::size_t> latch_correspondencet::latch_nodes() const
+{
+  std::vector<bool> is_latch_node(netlist.number_of_nodes(), false);
+
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch())
+      continue;
+
+    for(const auto &bit : var.bits)
+    {
+      if(!bit.current.is_constant() && netlist.get_node(bit.current).is_var())
+        is_latch_node[bit.current.var_no()] = true;
+    }
+  }
+
+  std::vector<std::size_t> result;
+
+  for(std::size_t n = 0; n < is_latch_node.size(); n++)
+    if(is_latch_node[n] && ternary_constants.count(n) == 0)
+      result.push_back(n);
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: latch_correspondencet::initial_state
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the values of the latch nodes in some initial state,
+          if there is one
+
+\*******************************************************************/
+
+std::optional<std::vector<bool>> latch_correspondencet::initial_state(
+  const std::vector<std::size_t> &latch_nodes)
+{
+  messaget message(message_handler);
+  satcheckt solver{message_handler};
+  bmc_mapt bmc_map(netlist, 1, solver);
+
+  unwind(netlist, bmc_map, message, solver, true);
+
+  if(solver.prop_solve() != propt::resultt::P_SATISFIABLE)
+    return {};
+
+  std::vector<bool> result;
+  result.reserve(latch_nodes.size());
+
+  for(auto n : latch_nodes)
+    result.push_back(solver.l_get(bmc_map.get(0, n)).is_true());
+
+  return result;
+}
+
+/*******************************************************************\
+
+Function: latch_correspondencet::simulate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the candidate classes, from the values of the latches in
+          a number of cycles of simulation with random inputs
+
+\*******************************************************************/
+
+void latch_correspondencet::simulate(
+  const std::vector<std::size_t> &latch_nodes,
+  const std::vector<bool> &initial_state)
+{
+  using wordt = netlist_simulatort::wordt;
+
+  const std::size_t cycles = 32;
+
+  std::vector<bool> is_latch_node(netlist.number_of_nodes(), false);
+  for(auto n : latch_nodes)
+    is_latch_node[n] = true;
+
+  netlist_simulatort simulator(netlist);
+  std::mt19937_64 random; // deterministic
+
+  // all runs start in the same initial state
+  for(std::size_t i = 0; i < latch_nodes.size(); i++)
+  {
+    simulator.set(
+      literalt(latch_nodes[i], false),
+      initial_state[i] ? ~wordt(0) : wordt(0));
+  }
+
+  for(const auto &[node, value] : ternary_constants)
+  {
+    is_latch_node[node] = true;
+    simulator.set(literalt(node, false), value ? ~wordt(0) : wordt(0));
+  }
+
+  std::vector<std::vector<wordt>> signatures(latch_nodes.size());
+
+  for(std::size_t cycle = 0; cycle < cycles; cycle++)
+  {
+    for(std::size_t n = 0; n < netlist.number_of_nodes(); n++)
+      if(netlist.nodes[n].is_var() && !is_latch_node[n])
+        simulator.set(literalt(n, false), random());
+
+    simulator.evaluate();
+
+    for(std::size_t i = 0; i < latch_nodes.size(); i++)
+      signatures[i].push_back(simulator.get(literalt(latch_nodes[i], false)));
+
+    simulator.next_state();
+  }
+
+  // Normalize the signatures such that the first run is zero, to
+  // find the latches that are equivalent up to negation.
+  std::map<std::vector<wordt>, classt> signature_classes;
+
+  for(std::size_t i = 0; i < latch_nodes.size(); i++)
+  {
+    auto &signature = signatures[i];
+    const bool phase = signature.front() & 1;
+
+    if(phase)
+    {
+      for(auto &word : signature)
+        word = ~word;
+    }
+
+    signature_classes[signature].push_back({latch_nodes[i], phase});
+  }
+
+  const std::vector<wordt> zero(cycles, 0);
+
+  for(auto &[signature, members] : signature_classes)
+  {
+    if(signature == zero)
+      constants = std::move(members);
+    else if(members.size() >= 2)
+      classes.push_back(std::move(members));
+  }
+}
+
+/*******************************************************************\
+
+Function: latch_correspondencet::refine
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Checks the candidates in the initial states (base case),
+          or in the successors of the states that satisfy them (step
+          case). Splits the classes that the counterexample violates,
+          and returns true, if there is one.
+
+\*******************************************************************/
+
+bool latch_correspondencet::refine(bool base_case)
+{
+  messaget message(message_handler);
+  satcheckt solver{message_handler};
+
+  const std::size_t timeframes = base_case ? 1 : 2;
+  bmc_mapt bmc_map(netlist, timeframes, solver);
+
+  unwind(netlist, bmc_map, message, solver, base_case);
+
+  auto literal = [&bmc_map](std::size_t t, const candidatet &candidate)
+  { return bmc_map.translate(t, candidate.literal()); };
+
+  // the step case assumes the candidates in the first timeframe,
+  // and the constants from ternary simulation, which are invariants
+  if(!base_case)
+  {
+    for(const auto &[node, value] : ternary_constants)
+      solver.l_set_to(bmc_map.translate(0, literalt(node, false)), value);
+
+    for(const auto &c : classes)
+      for(std::size_t i = 1; i < c.size(); i++)
+        solver.set_equal(literal(0, c[i]), literal(0, c.front()));
+
+    for(const auto &candidate : constants)
+      solver.l_set_to_false(literal(0, candidate));
+  }
+
+  // is any candidate violated in the last timeframe?
+  const std::size_t t = timeframes - 1;
+  bvt violated;
+
+  for(const auto &c : classes)
+  {
+    for(std::size_t i = 1; i < c.size(); i++)
+      violated.push_back(solver.lxor(literal(t, c[i]), literal(t, c.front())));
+  }
+
+  for(const auto &candidate : constants)
+    violated.push_back(literal(t, candidate));
+
+  if(violated.empty())
+    return false;
+
+  solver.lcnf(violated);
+
+  if(solver.prop_solve() != propt::resultt::P_SATISFIABLE)
+    return false;
+
+  auto value = [&](const candidatet &candidate)
+  { return solver.l_get(literal(t, candidate)).is_true(); };
+
+  // Split the classes by the values in the counterexample.
+  // This keeps the candidates in each class in increasing order.
+  std::vector<classt> new_classes;
+
+  for(const auto &c : classes)
+  {
+    const bool representative_value = value(c.front());
+    classt same, different;
+
+    for(const auto &candidate : c)
+    {
+      if(value(candidate) == representative_value)
+        same.push_back(candidate);
+      else
+        different.push_back(candidate);
+    }
+
+    if(same.size() >= 2)
+      new_classes.push_back(std::move(same));
+
+    if(different.size() >= 2)
+      new_classes.push_back(std::move(different));
+  }
+
+  classt new_constants, ones;
+
+  for(const auto &candidate : constants)
+  {
+    if(value(candidate))
+      ones.push_back(candidate);
+    else
+      new_constants.push_back(candidate);
+  }
+
+  if(ones.size() >= 2)
+    new_classes.push_back(std::move(ones));
+
+  classes = std::move(new_classes);
+  constants = std::move(new_constants);
+
+  return true;
+}
+
+/*******************************************************************\
+
+Function: latch_correspondencet::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::vector<literalt> latch_correspondencet::operator()()
+{
+  std::vector<literalt> equivalent;
+  equivalent.reserve(netlist.number_of_nodes());
+
+  for(std::size_t n = 0; n < netlist.number_of_nodes(); n++)
+    equivalent.push_back(literalt(n, false));
+
+  ternary_constants = constant_latches(netlist);
+
+  for(const auto &[node, value] : ternary_constants)
+    equivalent[node] = const_literal(value);
+
+  const auto nodes = latch_nodes();
+
+  if(nodes.empty())
+    return equivalent;
+
+  const auto initial = initial_state(nodes);
+
+  // without initial states, there is nothing to merge
+  if(!initial.has_value())
+    return equivalent;
+
+  simulate(nodes, *initial);
+
+  // Refining the classes only drops candidates, and hence, the base
+  // case still holds once the step case holds.
+  while(refine(true))
+    ;
+
+  while(refine(false))
+    ;
+
+  for(const auto &c : classes)
+  {
+    const auto &representative = c.front();
+
+    for(std::size_t i = 1; i < c.size(); i++)
+    {
+      equivalent[c[i].node] =
+        literalt(representative.node, c[i].phase != representative.phase);
+    }
+  }
+
+  for(const auto &candidate : constants)
+    equivalent[candidate.node] = const_literal(candidate.phase);
+
+  return equivalent;
+}
+
+/*******************************************************************\
+
+Function: latch_correspondence
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlistt
+latch_correspondence(const netlistt &src, message_handlert &message_handler)
+{
+  latch_correspondencet latch_correspondence{src, message_handler};
+  const auto equivalent = latch_correspondence();
+
+  // The latch variables whose bits are all merged become wires,
+  // which keeps them in the traces.
+  netlistt netlist = src;
+  std::size_t latch_bits = 0, merged_bits = 0;
+
+  for(auto &[id, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch())
+      continue;
+
+    bool all_merged = true;
+
+    for(const auto &bit : var.bits)
+    {
+      latch_bits++;
+
+      if(
+        !bit.current.is_constant() &&
+        equivalent[bit.current.var_no()] != literalt(bit.current.var_no(), false))
+      {
+        merged_bits++;
+      }
+      else
+        all_merged = false;
+    }
+
+    if(all_merged && !var.bits.empty())
+      var.vartype = var_mapt::vart::vartypet::WIRE;
+  }
+
+  netlistt result = substitute_nodes(netlist, equivalent);
+
+  messaget message(message_handler);
+  message.status() << "Latch correspondence: " << merged_bits << " of "
+                   << latch_bits << " latch bits merged, "
+                   << latch_correspondence.number_of_ternary_constants()
+                   << " constant by ternary simulation" << messaget::eom;
+
+  return result;
+}
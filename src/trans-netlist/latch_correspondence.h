@@ -0,0 +1,32 @@
+/*******************************************************************\
+
+Module: Latch Correspondence for Netlists
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Latch Correspondence for Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_LATCH_CORRESPONDENCE_H
+#define CPROVER_TRANS_NETLIST_LATCH_CORRESPONDENCE_H
+
+#include "netlist.h"
+
+class message_handlert;
+
+/// Finds the latches that are equivalent, up to negation, to another
+/// latch, or that are constant, in all reachable states, and merges
+/// them (signal correspondence, after van Eijk). The candidates come
+/// from bit-parallel simulation from an initial state, and are refined
+/// until they hold in the initial states and are inductive, assuming
+/// all of them in the previous state. The latches that ternary
+/// simulation shows to be constant are merged without further checks.
+/// A latch variable whose bits are all merged becomes a wire that is
+/// defined by the latches it is equivalent to, and hence, the traces
+/// still give its values. The uses of the other merged latch bits are
+/// replaced.
+netlistt latch_correspondence(const netlistt &, message_handlert &);
+
+#endif // CPROVER_TRANS_NETLIST_LATCH_CORRESPONDENCE_H
@@ -0,0 +1,408 @@
+/*******************************************************************\
+
+Module: Cone of Influence Reduction for Netlists
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "netlist_coi.h"
+
+#include <util/invariant.h>
+
+#include <unordered_set>
+
+/*******************************************************************\
+
+Function: netlist_property_literals
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bvt netlist_property_literals(const netlistt::propertyt &property)
+{
+  if(std::holds_alternative<netlistt::Gpt>(property))
+    return {std::get<netlistt::Gpt>(property).p};
+  else if(std::holds_alternative<netlistt::GFpt>(property))
+    return {std::get<netlistt::GFpt>(property).p};
+  else
+    UNREACHABLE;
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::netlist_coit
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlist_coit::netlist_coit(const netlistt &_src, const bvt &roots)
+  : src(_src)
+{
+  compute(roots);
+  build();
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::mark
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlist_coit::mark(literalt l)
+{
+  if(l.is_constant())
+    return;
+
+  std::size_t n = l.var_no();
+
+  if(!marked[n])
+  {
+    marked[n] = true;
+    stack.push_back(n);
+  }
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::mark_variable
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: a variable node has been added to the cone
+
+\*******************************************************************/
+
+void netlist_coit::mark_variable(std::size_t n)
+{
+  auto reverse_it = src.var_map.reverse_map.find(n);
+
+  if(reverse_it != src.var_map.reverse_map.end())
+  {
+    const auto &var = src.var_map.map.at(reverse_it->second.id);
+
+    // all bits of latches and inputs, and the
+    // next-state functions of the latches
+    if(var.is_latch() || var.is_input())
+    {
+      for(const auto &bit : var.bits)
+      {
+        mark(bit.current);
+        if(var.is_latch())
+          mark(bit.next);
+      }
+    }
+  }
+
+  // the initial state constraints that refer to the variable
+  auto conjuncts_it = conjuncts_of_var.find(n);
+
+  if(conjuncts_it != conjuncts_of_var.end())
+  {
+    for(auto i : conjuncts_it->second)
+    {
+      if(!initial_in_coi[i])
+      {
+        initial_in_coi[i] = true;
+        mark(initial_conjuncts[i]);
+      }
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::split_initial
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: split the initial state constraints into conjuncts,
+          and record the variables each conjunct refers to
+
+\*******************************************************************/
+
+void netlist_coit::split_initial()
+{
+  std::vector<literalt> todo(src.initial.rbegin(), src.initial.rend());
+
+  while(!todo.empty())
+  {
+    literalt l = todo.back();
+    todo.pop_back();
+
+    if(!l.is_constant() && !l.sign() && src.get_node(l).is_and())
+    {
+      todo.push_back(src.get_node(l).b);
+      todo.push_back(src.get_node(l).a);
+    }
+    else
+      initial_conjuncts.push_back(l);
+  }
+
+  initial_in_coi.resize(initial_conjuncts.size(), false);
+
+  for(std::size_t i = 0; i < initial_conjuncts.size(); i++)
+  {
+    literalt conjunct = initial_conjuncts[i];
+
+    if(conjunct.is_constant())
+    {
+      // keep these, as they might make the initial states empty
+      initial_in_coi[i] = true;
+      continue;
+    }
+
+    // find the variable nodes in the fan-in of the conjunct
+    std::unordered_set<std::size_t> seen;
+    std::vector<std::size_t> nodes = {conjunct.var_no()};
+
+    while(!nodes.empty())
+    {
+      std::size_t n = nodes.back();
+      nodes.pop_back();
+
+      if(!seen.insert(n).second)
+        continue;
+
+      const auto &node = src.nodes[n];
+
+      if(node.is_and())
+      {
+        if(!node.a.is_constant())
+          nodes.push_back(node.a.var_no());
+        if(!node.b.is_constant())
+          nodes.push_back(node.b.var_no());
+      }
+      else
+        conjuncts_of_var[n].push_back(i);
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::compute
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlist_coit::compute(const bvt &roots)
+{
+  marked.resize(src.number_of_nodes(), false);
+
+  split_initial();
+
+  for(std::size_t i = 0; i < initial_conjuncts.size(); i++)
+    if(initial_in_coi[i])
+      mark(initial_conjuncts[i]);
+
+  for(auto l : roots)
+    mark(l);
+
+  // the constraints restrict all paths, and hence,
+  // are always in the cone
+  for(auto l : src.constraints)
+    mark(l);
+
+  for(auto l : src.transition)
+    mark(l);
+
+  while(!stack.empty())
+  {
+    std::size_t n = stack.back();
+    stack.pop_back();
+
+    const auto &node = src.nodes[n];
+
+    if(node.is_and())
+    {
+      mark(node.a);
+      mark(node.b);
+    }
+    else
+      mark_variable(n);
+  }
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::translate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+literalt netlist_coit::translate(literalt l) const
+{
+  if(l.is_constant())
+    return l;
+
+  PRECONDITION(marked[l.var_no()]);
+
+  return node_map[l.var_no()] ^ l.sign();
+}
+
+/*******************************************************************\
+
+Function: netlist_coit::build
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlist_coit::build()
+{
+  // The nodes are in topological order.
+  node_map.resize(src.number_of_nodes(), const_literal(false));
+
+  for(std::size_t n = 0; n < src.number_of_nodes(); n++)
+  {
+    if(!marked[n])
+      continue;
+
+    const auto &node = src.nodes[n];
+
+    if(node.is_and())
+    {
+      node_map[n] =
+        netlist.new_and_node(translate(node.a), translate(node.b));
+    }
+    else
+      node_map[n] = netlist.new_var_node();
+  }
+
+  // the variables
+  for(const auto &[id, var] : src.var_map.map)
+  {
+    if(var.is_nondet())
+    {
+      // keep the nondets in the cone, with new bit numbers
+      var_mapt::vart new_var;
+      new_var.vartype = var.vartype;
+      new_var.type = var.type;
+      new_var.mode = var.mode;
+
+      for(const auto &bit : var.bits)
+      {
+        if(in_coi(bit.current))
+        {
+          auto &new_bit = new_var.add_bit();
+          new_bit.current = translate(bit.current);
+          new_bit.next = const_literal(false);
+        }
+      }
+
+      if(!new_var.bits.empty())
+        netlist.var_map.map.emplace(id, std::move(new_var));
+    }
+    else
+    {
+      bool keep = !var.bits.empty();
+
+      for(const auto &bit : var.bits)
+        if(!in_coi(bit.current))
+          keep = false;
+
+      if(!keep)
+        continue;
+
+      auto &new_var = netlist.var_map.map[id];
+      new_var = var;
+
+      for(auto &bit : new_var.bits)
+      {
+        bit.current = translate(bit.current);
+
+        if(var.is_latch())
+          bit.next = translate(bit.next);
+        else
+          bit.next = const_literal(false);
+      }
+    }
+  }
+
+  netlist.var_map.build_reverse_map();
+
+  // the reverse map for the nondets
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(var.is_nondet())
+    {
+      for(std::size_t bit_nr = 0; bit_nr < var.bits.size(); bit_nr++)
+      {
+        auto node = var.bits[bit_nr].current.var_no();
+        auto &reverse = netlist.var_map.reverse_map[node];
+        reverse.id = id;
+        reverse.bit_nr = bit_nr;
+      }
+    }
+  }
+
+  // constraints
+  for(std::size_t i = 0; i < initial_conjuncts.size(); i++)
+    if(initial_in_coi[i])
+      netlist.initial.push_back(translate(initial_conjuncts[i]));
+
+  for(auto l : src.constraints)
+    netlist.constraints.push_back(translate(l));
+
+  for(auto l : src.transition)
+    netlist.transition.push_back(translate(l));
+
+  // the properties in the cone
+  for(const auto &[id, property] : src.properties)
+  {
+    bool keep = true;
+
+    for(auto l : netlist_property_literals(property))
+      if(!in_coi(l))
+        keep = false;
+
+    if(!keep)
+      continue;
+
+    if(std::holds_alternative<netlistt::Gpt>(property))
+    {
+      netlist.properties.emplace(
+        id, netlistt::Gpt{translate(std::get<netlistt::Gpt>(property).p)});
+    }
+    else
+    {
+      netlist.properties.emplace(
+        id, netlistt::GFpt{translate(std::get<netlistt::GFpt>(property).p)});
+    }
+  }
+}
@@ -0,0 +1,71 @@
+/*******************************************************************\
+
+Module: Cone of Influence Reduction for Netlists
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Cone of Influence Reduction for Netlists
+
+#ifndef CPROVER_TRANS_NETLIST_COI_H
+#define CPROVER_TRANS_NETLIST_COI_H
+
+#include "netlist.h"
+
+#include <unordered_map>
+
+/// Computes the cone of influence of a set of netlist literals, i.e.,
+/// the nodes in their transitive fan-in, where a latch depends on its
+/// next-state function, and builds the netlist restricted to it.
+/// The general AIG constraints and the transition constraints are
+/// always in the cone. A conjunct of the initial state constraints is
+/// in the cone if it refers to a variable in the cone.
+/// Latches and inputs are kept or removed as a whole, to keep
+/// the traces readable.
+class netlist_coit
+{
+public:
+  netlist_coit(const netlistt &src, const bvt &roots);
+
+  /// the netlist restricted to the cone of influence,
+  /// including the properties whose nodes are in the cone
+  netlistt netlist;
+
+  /// translate a literal of the original netlist in the cone
+  /// into a literal of the reduced netlist
+  literalt translate(literalt) const;
+
+  bool in_coi(literalt l) const
+  {
+    return l.is_constant() || marked[l.var_no()];
+  }
+
+protected:
+  const netlistt &src;
+
+  // the nodes of 'src' in the cone
+  std::vector<bool> marked;
+  std::vector<std::size_t> stack;
+
+  // the conjuncts of the initial state constraints, and which
+  // of these refer to a given variable node
+  bvt initial_conjuncts;
+  std::vector<bool> initial_in_coi;
+  std::unordered_map<std::size_t, std::vector<std::size_t>> conjuncts_of_var;
+
+  // maps the nodes of 'src' to the literals in 'netlist'
+  std::vector<literalt> node_map;
+
+  void mark(literalt);
+  void mark_variable(std::size_t node);
+  void split_initial();
+  void compute(const bvt &roots);
+  void build();
+};
+
+/// the netlist literals of a netlist property
+bvt netlist_property_literals(const netlistt::propertyt &);
+
+#endif // CPROVER_TRANS_NETLIST_COI_H
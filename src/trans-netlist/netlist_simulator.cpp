@@ -0,0 +1,95 @@
+/*******************************************************************\
+
+Module: Bit-Parallel Netlist Simulation
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "netlist_simulator.h"
+
+/*******************************************************************\
+
+Function: netlist_simulatort::netlist_simulatort
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+netlist_simulatort::netlist_simulatort(const netlistt &_netlist)
+  : netlist(_netlist)
+{
+  values.resize(netlist.number_of_nodes(), 0);
+
+  for(std::size_t n = 0; n < netlist.number_of_nodes(); n++)
+  {
+    const auto &node = netlist.nodes[n];
+    if(node.is_and())
+      and_gates.push_back({n, node.a, node.b});
+  }
+
+  // Latch bits whose current-state literal is a constant or is
+  // not a variable node, e.g., owing to an optimization, cannot be set.
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(var.is_latch())
+    {
+      for(const auto &bit : var.bits)
+      {
+        if(
+          !bit.current.is_constant() &&
+          netlist.get_node(bit.current).is_var())
+        {
+          latch_bits.push_back(bit);
+        }
+      }
+    }
+  }
+
+  next_values.resize(latch_bits.size());
+}
+
+/*******************************************************************\
+
+Function: netlist_simulatort::evaluate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlist_simulatort::evaluate()
+{
+  for(const auto &gate : and_gates)
+    values[gate.node] = get(gate.a) & get(gate.b);
+}
+
+/*******************************************************************\
+
+Function: netlist_simulatort::next_state
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void netlist_simulatort::next_state()
+{
+  // The next-state functions refer to the current state,
+  // hence evaluate all of them before updating any latch.
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+    next_values[i] = get(latch_bits[i].next);
+
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+    set(latch_bits[i].current, next_values[i]);
+}
@@ -0,0 +1,78 @@
+/*******************************************************************\
+
+Module: Bit-Parallel Netlist Simulation
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Bit-Parallel Netlist Simulation
+
+#ifndef CPROVER_TRANS_NETLIST_SIMULATOR_H
+#define CPROVER_TRANS_NETLIST_SIMULATOR_H
+
+#include "netlist.h"
+
+#include <cstdint>
+
+/// Simulates a netlist on 64 independent runs at once. Each node
+/// carries a machine word, and bit i of that word is the value of
+/// the node in run i. The AND nodes are evaluated in topological
+/// order, which is the order in which they are stored in the netlist.
+/// Variable nodes that are never set have value zero.
+class netlist_simulatort
+{
+public:
+  using wordt = std::uint64_t;
+  static constexpr std::size_t lanes = 64;
+
+  explicit netlist_simulatort(const netlistt &);
+
+  /// set the value of the given literal, which must denote a variable node
+  void set(literalt l, wordt value)
+  {
+    PRECONDITION(!l.is_constant());
+    PRECONDITION(netlist.nodes[l.var_no()].is_var());
+    values[l.var_no()] = l.sign() ? ~value : value;
+  }
+
+  wordt get(literalt l) const
+  {
+    if(l.is_constant())
+      return l.is_true() ? ~wordt(0) : wordt(0);
+    else
+      return l.sign() ? ~values[l.var_no()] : values[l.var_no()];
+  }
+
+  /// the value of the given literal in the given run
+  bool get(literalt l, std::size_t lane) const
+  {
+    return (get(l) >> lane) & 1;
+  }
+
+  /// evaluate the AND nodes, given the values of the variable nodes
+  void evaluate();
+
+  /// assign the values of the next-state functions to the latches
+  void next_state();
+
+protected:
+  const netlistt &netlist;
+  std::vector<wordt> values;
+
+  // the AND nodes in topological order
+  struct and_gatet
+  {
+    std::size_t node;
+    literalt a, b;
+  };
+
+  std::vector<and_gatet> and_gates;
+
+  // the current-state and next-state literals of the latch bits
+  std::vector<var_mapt::vart::bitt> latch_bits;
+  std::vector<wordt> next_values;
+};
+
+#endif // CPROVER_TRANS_NETLIST_SIMULATOR_H
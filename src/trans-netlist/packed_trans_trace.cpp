@@ -0,0 +1,478 @@
+/*******************************************************************\
+
+Module: Compact Representation of Traces
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "packed_trans_trace.h"
+
+#include <util/arith_tools.h>
+#include <util/bitvector_types.h>
+#include <util/json.h>
+#include <util/std_expr.h>
+#include <util/xml.h>
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::packed_trans_tracet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+packed_trans_tracet::packed_trans_tracet(const trans_tracet &trace)
+  : mode(trace.mode)
+{
+  for(const auto &state : trace.states)
+    push_back(state);
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::signal
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: find or add the signal with the given lhs
+
+\*******************************************************************/
+
+packed_trans_tracet::signalt &packed_trans_tracet::signal(const exprt &lhs)
+{
+  PRECONDITION(lhs.id() == ID_symbol);
+  auto identifier = to_symbol_expr(lhs).get_identifier();
+
+  auto number_it = signal_numbers.find(identifier);
+  if(number_it != signal_numbers.end())
+    return signals[number_it->second];
+
+  signal_numbers.emplace(identifier, signals.size());
+  signals.emplace_back();
+  auto &signal = signals.back();
+  signal.lhs = lhs;
+
+  const auto &type = lhs.type();
+
+  if(type.id() == ID_bool)
+    signal.width = 1;
+  else if(
+    type.id() == ID_unsignedbv || type.id() == ID_signedbv ||
+    type.id() == ID_bv)
+  {
+    signal.width = to_bitvector_type(type).get_width();
+  }
+
+  // the signal is not assigned in the earlier timeframes
+  const std::size_t timeframes = number_of_timeframes();
+  signal.assigned.resize(timeframes, false);
+  signal.has_value.resize(timeframes, false);
+  signal.bits.resize(timeframes * signal.width, false);
+
+  return signal;
+}
+
+/*******************************************************************\
+
+Function: unpack_value
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the constant given by the bits from the given offset
+
+\*******************************************************************/
+
+static constant_exprt unpack_value(
+  const std::vector<bool> &bits,
+  std::size_t offset,
+  std::size_t width,
+  const typet &type)
+{
+  if(type.id() == ID_bool)
+    return constant_exprt(bits[offset] ? ID_true : ID_false, type);
+  else
+  {
+    return constant_exprt(
+      make_bvrep(width, [&](std::size_t i) { return bits[offset + i]; }),
+      type);
+  }
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::pack
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: stores the value of the last timeframe in the bits, if
+          it can be restored exactly
+
+\*******************************************************************/
+
+bool packed_trans_tracet::pack(signalt &signal, const exprt &value)
+{
+  const auto &type = signal.lhs.type();
+
+  if(signal.width == 0 || value.id() != ID_constant || value.type() != type)
+    return false;
+
+  const auto &constant = to_constant_expr(value);
+  const std::size_t offset = signal.bits.size() - signal.width;
+
+  if(type.id() == ID_bool)
+    signal.bits[offset] = constant.is_true();
+  else
+  {
+    for(std::size_t i = 0; i < signal.width; i++)
+    {
+      signal.bits[offset + i] =
+        get_bvrep_bit(constant.get_value(), signal.width, i);
+    }
+  }
+
+  // e.g., constants with comments are kept as they are
+  return unpack_value(signal.bits, offset, signal.width, type).full_eq(value);
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::push_back
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void packed_trans_tracet::push_back(const trans_tracet::statet &state)
+{
+  const std::size_t t = number_of_timeframes();
+
+  for(const auto &assignment : state.assignments)
+  {
+    auto &signal = this->signal(assignment.lhs);
+
+    PRECONDITION_WITH_DIAGNOSTICS(
+      signal.assigned.size() == t,
+      "a state assigns a signal at most once",
+      assignment.lhs.pretty());
+
+    const exprt &value = assignment.rhs;
+
+    signal.assigned.push_back(true);
+    signal.has_value.push_back(value.is_not_nil());
+    signal.bits.resize((t + 1) * signal.width, false);
+
+    if(value.is_not_nil() && !pack(signal, value))
+      signal.expressions.emplace(t, value);
+
+    if(assignment.location.is_not_nil())
+      signal.locations.emplace(t, assignment.location);
+  }
+
+  // the signals that the state does not assign
+  for(auto &signal : signals)
+  {
+    if(signal.assigned.size() == t)
+    {
+      signal.assigned.push_back(false);
+      signal.has_value.push_back(false);
+      signal.bits.resize((t + 1) * signal.width, false);
+    }
+  }
+
+  property_failed.push_back(state.property_failed);
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::state
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+trans_tracet::statet packed_trans_tracet::state(std::size_t t) const
+{
+  PRECONDITION(t < number_of_timeframes());
+
+  trans_tracet::statet state;
+  state.property_failed = property_failed[t];
+
+  for(const auto &signal : signals)
+  {
+    if(!signal.assigned[t])
+      continue;
+
+    exprt value;
+
+    if(!signal.has_value[t])
+      value = nil_exprt();
+    else
+    {
+      auto expression_it = signal.expressions.find(t);
+
+      if(expression_it != signal.expressions.end())
+        value = expression_it->second;
+      else
+      {
+        value = unpack_value(
+          signal.bits, t * signal.width, signal.width, signal.lhs.type());
+      }
+    }
+
+    auto location_it = signal.locations.find(t);
+
+    state.assignments.emplace_back(
+      signal.lhs,
+      std::move(value),
+      location_it == signal.locations.end() ? source_locationt::nil()
+                                            : location_it->second);
+  }
+
+  return state;
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::unpack
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+trans_tracet packed_trans_tracet::unpack() const
+{
+  trans_tracet trace;
+  trace.mode = mode;
+  trace.states.reserve(number_of_timeframes());
+
+  for(std::size_t t = 0; t < number_of_timeframes(); t++)
+    trace.states.push_back(state(t));
+
+  return trace;
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_max_failing_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<std::size_t>
+packed_trans_tracet::get_max_failing_timeframe() const
+{
+  for(std::size_t t = number_of_timeframes(); t != 0; t--)
+    if(property_failed[t - 1])
+      return t - 1;
+
+  return {};
+}
+
+/*******************************************************************\
+
+Function: packed_trans_tracet::get_min_failing_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::optional<std::size_t>
+packed_trans_tracet::get_min_failing_timeframe() const
+{
+  for(std::size_t t = 0; t < number_of_timeframes(); t++)
+    if(property_failed[t])
+      return t;
+
+  return {};
+}
+
+/*******************************************************************\
+
+Function: output_trans_trace
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void output_trans_trace(
+  const packed_trans_tracet &trace,
+  trans_trace_sinkt &sink)
+{
+  for(std::size_t t = 0; t < trace.number_of_timeframes(); t++)
+    sink.state(trace.state(t));
+
+  sink.finish();
+}
+
+/*******************************************************************\
+
+Function: json
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+jsont json(const packed_trans_tracet &trace, const namespacet &ns)
+{
+  json_objectt json_trace;
+
+  json_trace["mode"] = json_stringt(trace.mode);
+  json_arrayt &json_states = json_trace["states"].make_array();
+
+  for(std::size_t t = 0; t < trace.number_of_timeframes(); t++)
+  {
+    auto state = trace.state(t);
+
+    json_states.push_back(json(state, ns));
+
+    if(state.property_failed)
+      break; // done
+  }
+
+  return std::move(json_trace);
+}
+
+/*******************************************************************\
+
+Function: xml
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+xmlt xml(const packed_trans_tracet &trace, const namespacet &ns)
+{
+  PRECONDITION(trace.number_of_timeframes() != 0);
+
+  auto last_time_frame = trace.get_min_failing_timeframe().value_or(
+    trace.number_of_timeframes() - 1);
+
+  xmlt dest = xmlt{"trans_trace"};
+
+  dest.new_element("mode").data = trace.mode;
+
+  for(std::size_t t = 0; t <= last_time_frame; t++)
+    dest.new_element(xml(trace.state(t), t, ns));
+
+  return dest;
+}
+
+/*******************************************************************\
+
+Function: show_trans_trace
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void show_trans_trace(
+  const packed_trans_tracet &trace,
+  messaget &,
+  const namespacet &ns,
+  std::ostream &)
+{
+  PRECONDITION(trace.number_of_timeframes() != 0);
+
+  auto l = trace.get_min_failing_timeframe().value_or(
+    trace.number_of_timeframes() - 1);
+
+  for(std::size_t t = 0; t <= l; t++)
+    show_trans_state(t, trace.state(t), ns);
+}
+
+/*******************************************************************\
+
+Function: show_trans_trace_vcd
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void show_trans_trace_vcd(
+  const packed_trans_tracet &trace,
+  messaget &,
+  const namespacet &ns,
+  std::ostream &out)
+{
+  vcd_trace_sinkt sink(ns, out);
+  output_trans_trace(trace, sink);
+}
+
+/*******************************************************************\
+
+Function: show_trans_trace_numbered
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void show_trans_trace_numbered(
+  const packed_trans_tracet &trace,
+  messaget &,
+  const namespacet &ns,
+  std::ostream &)
+{
+  PRECONDITION(trace.number_of_timeframes() != 0);
+
+  auto l = trace.get_min_failing_timeframe().value_or(
+    trace.number_of_timeframes() - 1);
+
+  for(std::size_t t = 0; t <= l; t++)
+    show_trans_state_numbered(t, trace.state(t), ns);
+}
@@ -0,0 +1,128 @@
+/*******************************************************************\
+
+Module: Compact Representation of Traces
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Compact Representation of Traces
+
+#ifndef CPROVER_TRANS_NETLIST_PACKED_TRANS_TRACE_H
+#define CPROVER_TRANS_NETLIST_PACKED_TRANS_TRACE_H
+
+#include "trans_trace.h"
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+/// A trace stored by signal rather than by state. There is a table of
+/// the signals, and the values of each signal are stored as one packed
+/// bit-vector across all timeframes. Values that are not constants of
+/// a bit-vector type, and constants that carry further annotations, are
+/// kept as expressions, and hence, a trace converts back exactly.
+class packed_trans_tracet
+{
+public:
+  packed_trans_tracet() = default;
+
+  // not explicit, to allow assigning a trans_tracet
+  packed_trans_tracet(const trans_tracet &);
+
+  std::string mode;
+
+  std::size_t number_of_timeframes() const
+  {
+    return property_failed.size();
+  }
+
+  /// appends a state
+  void push_back(const trans_tracet::statet &);
+
+  /// the state in the given timeframe
+  trans_tracet::statet state(std::size_t timeframe) const;
+
+  trans_tracet unpack() const;
+
+  // returns the latest failing timeframe, if any
+  std::optional<std::size_t> get_max_failing_timeframe() const;
+
+  // returns the earliest failing timeframe, if any
+  std::optional<std::size_t> get_min_failing_timeframe() const;
+
+protected:
+  struct signalt
+  {
+    exprt lhs;
+
+    // the number of bits of a packed value, zero if the values
+    // are always kept as expressions
+    std::size_t width = 0;
+
+    // Bit i of the value in timeframe t is bits[t*width+i].
+    std::vector<bool> bits;
+
+    // whether the state in timeframe t has an assignment to
+    // the signal, and whether that has a value
+    std::vector<bool> assigned, has_value;
+
+    // the values that are not packed, by timeframe
+    std::map<std::size_t, exprt> expressions;
+
+    std::map<std::size_t, source_locationt> locations;
+  };
+
+  std::vector<signalt> signals;
+  std::unordered_map<irep_idt, std::size_t, irep_id_hash> signal_numbers;
+  std::vector<bool> property_failed;
+
+  signalt &signal(const exprt &lhs);
+  static bool pack(signalt &, const exprt &value);
+};
+
+/// collects the states into a packed trace
+class packed_trans_trace_sinkt : public trans_trace_sinkt
+{
+public:
+  explicit packed_trans_trace_sinkt(packed_trans_tracet &_dest) : dest(_dest)
+  {
+  }
+
+  void state(const trans_tracet::statet &state) override
+  {
+    dest.push_back(state);
+  }
+
+protected:
+  packed_trans_tracet &dest;
+};
+
+// outputting packed traces, one state at a time
+
+void output_trans_trace(const packed_trans_tracet &, trans_trace_sinkt &);
+
+jsont json(const packed_trans_tracet &, const namespacet &);
+
+xmlt xml(const packed_trans_tracet &, const namespacet &);
+
+void show_trans_trace(
+  const packed_trans_tracet &,
+  messaget &,
+  const namespacet &,
+  std::ostream &);
+
+void show_trans_trace_vcd(
+  const packed_trans_tracet &,
+  messaget &,
+  const namespacet &,
+  std::ostream &);
+
+void show_trans_trace_numbered(
+  const packed_trans_tracet &,
+  messaget &,
+  const namespacet &,
+  std::ostream &);
+
+#endif // CPROVER_TRANS_NETLIST_PACKED_TRANS_TRACE_H
@@ -0,0 +1,163 @@
+/*******************************************************************\
+
+Module: Ternary Netlist Simulation
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+#include "ternary_simulator.h"
+
+/*******************************************************************\
+
+Function: ternary_simulatort::ternary_simulatort
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+ternary_simulatort::ternary_simulatort(const netlistt &_netlist)
+  : netlist(_netlist)
+{
+  values.resize(netlist.number_of_nodes(), tvt::unknown());
+
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(var.is_latch())
+    {
+      for(const auto &bit : var.bits)
+      {
+        if(
+          !bit.current.is_constant() &&
+          netlist.get_node(bit.current).is_var())
+        {
+          latch_bits.push_back(bit);
+        }
+      }
+    }
+  }
+
+  next_values.resize(latch_bits.size(), tvt::unknown());
+}
+
+/*******************************************************************\
+
+Function: ternary_simulatort::evaluate
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void ternary_simulatort::evaluate()
+{
+  for(std::size_t n = 0; n < netlist.number_of_nodes(); n++)
+  {
+    const auto &node = netlist.nodes[n];
+    if(node.is_and())
+      values[n] = get(node.a) && get(node.b);
+  }
+}
+
+/*******************************************************************\
+
+Function: ternary_simulatort::next_state
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+bool ternary_simulatort::next_state(bool join)
+{
+  // The next-state functions refer to the current state,
+  // hence evaluate all of them before updating any latch.
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+    next_values[i] = get(latch_bits[i].next);
+
+  bool changed = false;
+
+  for(std::size_t i = 0; i < latch_bits.size(); i++)
+  {
+    const literalt current = latch_bits[i].current;
+    tvt value = next_values[i];
+
+    if(join && value != get(current))
+      value = tvt::unknown();
+
+    if(value != get(current))
+    {
+      set(current, value);
+      changed = true;
+    }
+  }
+
+  return changed;
+}
+
+/*******************************************************************\
+
+Function: constant_latches
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+std::map<std::size_t, bool> constant_latches(const netlistt &netlist)
+{
+  ternary_simulatort simulator(netlist);
+
+  // the initial-state literals that fix a latch bit
+  for(auto l : netlist.initial)
+  {
+    if(
+      !l.is_constant() && netlist.get_node(l).is_var() &&
+      netlist.var_map.latches.count(l.var_no()) != 0)
+    {
+      simulator.set(l, tvt(true));
+    }
+  }
+
+  // Known values only ever become unknown, and hence, this
+  // takes at most one step per latch bit.
+  do
+  {
+    simulator.evaluate();
+  } while(simulator.next_state(true));
+
+  std::map<std::size_t, bool> result;
+
+  for(const auto &[id, var] : netlist.var_map.map)
+  {
+    if(!var.is_latch())
+      continue;
+
+    for(const auto &bit : var.bits)
+    {
+      if(bit.current.is_constant() || !netlist.get_node(bit.current).is_var())
+        continue;
+
+      const literalt l(bit.current.var_no(), false);
+      const tvt value = simulator.get(l);
+
+      if(value.is_known())
+        result[l.var_no()] = value.is_true();
+    }
+  }
+
+  return result;
+}
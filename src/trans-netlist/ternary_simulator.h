@@ -0,0 +1,73 @@
+/*******************************************************************\
+
+Module: Ternary Netlist Simulation
+
+Author: Daniel Kroening, kroening@kroening.com
+
+\*******************************************************************/
+
+/// \file
+/// Ternary Netlist Simulation
+
+#ifndef CPROVER_TRANS_NETLIST_TERNARY_SIMULATOR_H
+#define CPROVER_TRANS_NETLIST_TERNARY_SIMULATOR_H
+
+#include <util/threeval.h>
+
+#include "netlist.h"
+
+#include <map>
+
+/// Simulates a netlist with the values 0, 1 and X (unknown). An unknown
+/// value stands for both 0 and 1, and hence, a node with a known value
+/// has that value for all values of the unknown variable nodes.
+/// The AND nodes are evaluated in topological order, which is the order
+/// in which they are stored in the netlist. Variable nodes that are
+/// never set are unknown.
+class ternary_simulatort
+{
+public:
+  explicit ternary_simulatort(const netlistt &);
+
+  /// set the value of the given literal, which must denote a variable node
+  void set(literalt l, tvt value)
+  {
+    PRECONDITION(!l.is_constant());
+    PRECONDITION(netlist.nodes[l.var_no()].is_var());
+    values[l.var_no()] = l.sign() ? !value : value;
+  }
+
+  tvt get(literalt l) const
+  {
+    if(l.is_constant())
+      return tvt(l.is_true());
+    else
+      return l.sign() ? !values[l.var_no()] : values[l.var_no()];
+  }
+
+  /// evaluate the AND nodes, given the values of the variable nodes
+  void evaluate();
+
+  /// Assign the values of the next-state functions to the latches.
+  /// With \p join set, a latch whose next value differs from its
+  /// current value becomes unknown. Returns true if any latch changed.
+  bool next_state(bool join = false);
+
+protected:
+  const netlistt &netlist;
+  std::vector<tvt> values;
+
+  // the current-state and next-state literals of the latch bits
+  std::vector<var_mapt::vart::bitt> latch_bits;
+  std::vector<tvt> next_values;
+};
+
+/// The latch bits that have the same value in all reachable states, as
+/// the values of their variable nodes. Starting from the initial state,
+/// with the latches that the initial-state literals do not fix unknown,
+/// the next states are joined with the current ones, with unknown
+/// inputs, until nothing changes. The constraints are ignored, which
+/// only adds states.
+std::map<std::size_t, bool> constant_latches(const netlistt &);
+
+#endif // CPROVER_TRANS_NETLIST_TERNARY_SIMULATOR_H
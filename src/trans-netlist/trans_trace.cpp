@@ -77,6 +77,91 @@ std::optional<std::size_t> trans_tracet::get_min_failing_timeframe() const
 
 /*******************************************************************\
 
+Function: to_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Transform trans_tracet to an irep, e.g., for serialization
+
+\*******************************************************************/
+
+irept to_irep(const trans_tracet &trace)
+{
+  irept dest{ID_trans_trace};
+
+  dest.set(ID_mode, trace.mode);
+
+  auto &dest_states = dest.get_sub();
+  dest_states.reserve(trace.states.size());
+
+  for(auto &state : trace.states)
+  {
+    irept dest_state{ID_trans_trace_state};
+    dest_state.set(ID_property_failed, state.property_failed);
+
+    auto &dest_assignments = dest_state.get_sub();
+
+    for(auto &a : state.assignments)
+    {
+      irept dest_assignment{ID_trans_trace_assignment};
+      dest_assignment.add(ID_lhs) = a.lhs;
+      dest_assignment.add(ID_rhs) = a.rhs;
+      dest_assignment.add(ID_C_source_location) = a.location;
+      dest_assignments.push_back(std::move(dest_assignment));
+    }
+
+    dest_states.push_back(std::move(dest_state));
+  }
+
+  return dest;
+}
+
+/*******************************************************************\
+
+Function: trans_trace_from_irep
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: Inverse of to_irep
+
+\*******************************************************************/
+
+trans_tracet trans_trace_from_irep(const irept &src)
+{
+  PRECONDITION(src.id() == ID_trans_trace);
+
+  trans_tracet trace;
+  trace.mode = src.get_string(ID_mode);
+  trace.states.reserve(src.get_sub().size());
+
+  for(auto &src_state : src.get_sub())
+  {
+    DATA_INVARIANT(
+      src_state.id() == ID_trans_trace_state, "expected trans_trace_state");
+
+    trace.states.emplace_back();
+    auto &state = trace.states.back();
+    state.property_failed = src_state.get_bool(ID_property_failed);
+
+    for(auto &src_assignment : src_state.get_sub())
+    {
+      state.assignments.emplace_back(
+        static_cast<const exprt &>(src_assignment.find(ID_lhs)),
+        static_cast<const exprt &>(src_assignment.find(ID_rhs)),
+        static_cast<const source_locationt &>(
+          src_assignment.find(ID_C_source_location)));
+    }
+  }
+
+  return trace;
+}
+
+/*******************************************************************\
+
 Function: bvrep2binary
 
   Inputs:
@@ -220,48 +305,68 @@ xmlt xml(const trans_tracet &trace, const namespacet &ns)
   for(std::size_t t = 0; t <= last_time_frame; t++)
   {
     assert(t<trace.states.size());
-  
-    xmlt &xml_state=dest.new_element("state");
-    const trans_tracet::statet &state=trace.states[t];
+    dest.new_element(xml(trace.states[t], t, ns));
+  }
 
-    xml_state.new_element("timeframe").data=std::to_string(t); // will go away
-    xml_state.set_attribute("timeframe", t);
-    
-    for(const auto & a : state.assignments)
-    {
-      xmlt &xml_assignment=xml_state.new_element("assignment");
+  return dest;
+}
 
-      assert(a.lhs.id()==ID_symbol);
-      const symbolt &symbol=ns.lookup(to_symbol_expr(a.lhs));
+/*******************************************************************\
 
-      std::string value_string=from_expr(ns, symbol.name, a.rhs);
-      std::string type_string=from_type(ns, symbol.name, symbol.type);
+Function: xml
 
-      if(a.rhs.is_nil())
-        value_string="?";
-      else
-        xml_assignment.new_element("value_expression").new_element(xml(a.rhs, ns));
+  Inputs:
 
-      xml_assignment.new_element("identifier").data=id2string(symbol.name);
-      xml_assignment.new_element("base_name").data=id2string(symbol.base_name);
-      xml_assignment.new_element("display_name").data=id2string(symbol.display_name());
-      xml_assignment.new_element("value").data=value_string;
-      xml_assignment.new_element("type").data=type_string;
-      xml_assignment.new_element("mode").data=id2string(symbol.mode);
+ Outputs:
 
-      #if 0
-      if(a.location.is_not_nil())
-      {
-        xmlt &xml_location=xml_assignment.new_element();
+ Purpose: Transform a state of a trans_tracet to XML
 
-        convert(a.location, xml_location);
-        xml_location.name="location";
-      }
-      #endif
+\*******************************************************************/
+
+xmlt xml(
+  const trans_tracet::statet &state,
+  std::size_t t,
+  const namespacet &ns)
+{
+  xmlt xml_state{"state"};
+
+  xml_state.new_element("timeframe").data=std::to_string(t); // will go away
+  xml_state.set_attribute("timeframe", t);
+  
+  for(const auto & a : state.assignments)
+  {
+    xmlt &xml_assignment=xml_state.new_element("assignment");
+
+    assert(a.lhs.id()==ID_symbol);
+    const symbolt &symbol=ns.lookup(to_symbol_expr(a.lhs));
+
+    std::string value_string=from_expr(ns, symbol.name, a.rhs);
+    std::string type_string=from_type(ns, symbol.name, symbol.type);
+
+    if(a.rhs.is_nil())
+      value_string="?";
+    else
+      xml_assignment.new_element("value_expression").new_element(xml(a.rhs, ns));
+
+    xml_assignment.new_element("identifier").data=id2string(symbol.name);
+    xml_assignment.new_element("base_name").data=id2string(symbol.base_name);
+    xml_assignment.new_element("display_name").data=id2string(symbol.display_name());
+    xml_assignment.new_element("value").data=value_string;
+    xml_assignment.new_element("type").data=type_string;
+    xml_assignment.new_element("mode").data=id2string(symbol.mode);
+
+    #if 0
+    if(a.location.is_not_nil())
+    {
+      xmlt &xml_location=xml_assignment.new_element();
+
+      convert(a.location, xml_location);
+      xml_location.name="location";
     }
+    #endif
   }
 
-  return dest;
+  return xml_state;
 }
 
 /*******************************************************************\
@@ -272,55 +377,72 @@ Function: json
 
  Outputs:
 
- Purpose:
+ Purpose: the assignments of a state
 
 \*******************************************************************/
 
-jsont json(const trans_tracet &trace, const namespacet &ns)
+jsont json(const trans_tracet::statet &state, const namespacet &ns)
 {
-  json_objectt json_trace;
+  json_arrayt json_assignments;
 
-  json_trace["mode"] = json_stringt(trace.mode);
-  json_arrayt &json_states = json_trace["states"].make_array();
-
-  for(auto &state : trace.states)
+  for(const auto &a : state.assignments)
   {
-    json_arrayt json_assignments;
+    json_objectt json_assignment;
 
-    for(const auto &a : state.assignments)
-    {
-      json_objectt json_assignment;
+    DATA_INVARIANT(a.lhs.id() == ID_symbol, "assignment lhs must be symbol");
+    const symbolt &symbol = ns.lookup(to_symbol_expr(a.lhs));
 
-      DATA_INVARIANT(a.lhs.id() == ID_symbol, "assignment lhs must be symbol");
-      const symbolt &symbol = ns.lookup(to_symbol_expr(a.lhs));
+    if(symbol.is_auxiliary)
+      continue; // drop
 
-      if(symbol.is_auxiliary)
-        continue; // drop
+    std::string lhs_string = from_expr(ns, symbol.name, a.lhs);
 
-      std::string lhs_string = from_expr(ns, symbol.name, a.lhs);
+    std::string value_string =
+      a.rhs.is_nil() ? "" : from_expr(ns, symbol.name, a.rhs);
 
-      std::string value_string =
-        a.rhs.is_nil() ? "" : from_expr(ns, symbol.name, a.rhs);
+    std::string type_string = from_type(ns, symbol.name, symbol.type);
 
-      std::string type_string = from_type(ns, symbol.name, symbol.type);
+    json_assignment["lhs"] = json_stringt(lhs_string);
+    json_assignment["identifier"] = json_stringt(id2string(symbol.name));
+    json_assignment["base_name"] = json_stringt(id2string(symbol.base_name));
+    json_assignment["display_name"] =
+      json_stringt(id2string(symbol.display_name()));
+    json_assignment["value"] = json_stringt(value_string);
+    json_assignment["lhs_type"] = json_stringt(type_string);
+    json_assignment["mode"] = json_stringt(id2string(symbol.mode));
+    json_assignment["state_var"] = jsont::json_boolean(symbol.is_state_var);
 
-      json_assignment["lhs"] = json_stringt(lhs_string);
-      json_assignment["identifier"] = json_stringt(id2string(symbol.name));
-      json_assignment["base_name"] = json_stringt(id2string(symbol.base_name));
-      json_assignment["display_name"] =
-        json_stringt(id2string(symbol.display_name()));
-      json_assignment["value"] = json_stringt(value_string);
-      json_assignment["lhs_type"] = json_stringt(type_string);
-      json_assignment["mode"] = json_stringt(id2string(symbol.mode));
-      json_assignment["state_var"] = jsont::json_boolean(symbol.is_state_var);
+    if(a.location.is_not_nil())
+      json_assignment["location"] = json(a.location);
 
-      if(a.location.is_not_nil())
-        json_assignment["location"] = json(a.location);
+    json_assignments.push_back(std::move(json_assignment));
+  }
 
-      json_assignments.push_back(std::move(json_assignment));
-    }
+  return json_assignments;
+}
+
+/*******************************************************************\
+
+Function: json
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+jsont json(const trans_tracet &trace, const namespacet &ns)
+{
+  json_objectt json_trace;
+
+  json_trace["mode"] = json_stringt(trace.mode);
+  json_arrayt &json_states = json_trace["states"].make_array();
 
-    json_states.push_back(std::move(json_assignments));
+  for(auto &state : trace.states)
+  {
+    json_states.push_back(json(state, ns));
 
     if(state.property_failed)
       break; // done
@@ -572,19 +694,13 @@ Function: show_trans_state_vcd
 
 void show_trans_state_vcd(
   std::size_t timeframe,
-  const trans_tracet::statet &previous_state,
+  const std::map<irep_idt, exprt> &previous_values,
   const trans_tracet::statet &current_state,
   const namespacet &ns,
   std::ostream &out)
 {
   out << "#" << timeframe << '\n';
 
-  // build map for previous state  
-  std::map<irep_idt, exprt> previous_values;
-
-  for(const auto & a : previous_state.assignments)
-    previous_values[a.lhs.get(ID_identifier)]=a.rhs;
-
   // now dump current state
   for(const auto & a : current_state.assignments)
   {
@@ -597,8 +713,14 @@ void show_trans_state_vcd(
       continue;
     
     if(timeframe!=0)
-      if(previous_values[symbol.name]==a.rhs)
+    {
+      auto previous_it = previous_values.find(symbol.name);
+      bool unchanged = previous_it == previous_values.end()
+                         ? a.rhs.is_nil()
+                         : previous_it->second == a.rhs;
+      if(unchanged)
         continue; // value didn't change!
+    }
   
     if(a.rhs.is_nil()) // no value
       continue;
@@ -789,20 +911,50 @@ Function: show_trans_trace_vcd
 
 void show_trans_trace_vcd(
   const trans_tracet &trace,
-  messaget &message,
+  messaget &,
   const namespacet &ns,
   std::ostream &out)
+{
+  vcd_trace_sinkt sink(ns, out);
+  output_trans_trace(trace, sink);
+}
+
+/*******************************************************************\
+
+Function: vcd_trace_sinkt::vcd_trace_sinkt
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+vcd_trace_sinkt::vcd_trace_sinkt(const namespacet &_ns, std::ostream &_out)
+  : ns(_ns), out(_out)
 {
   time_t t;
   time(&t);
   out << "$date\n  " << ctime(&t) << "$end" << '\n';
 
   out << "$timescale\n  1ns\n$end" << '\n';
-  
-  if(trace.states.empty()) return;
+}
+
+/*******************************************************************\
+
+Function: vcd_trace_sinkt::header
+
+  Inputs:
 
-  const trans_tracet::statet &state=trace.states[0];
+ Outputs:
+
+ Purpose: the signal definitions, given by the first state
+
+\*******************************************************************/
 
+void vcd_trace_sinkt::header(const trans_tracet::statet &state)
+{
   assert(!state.assignments.empty());
 
   // get identifiers
@@ -831,17 +983,61 @@ void show_trans_trace_vcd(
   out << "$upscope $end\n";  
 
   out << "$enddefinitions $end\n";
+}
 
-  auto l = trace.get_min_failing_timeframe().value_or(trace.states.size() - 1);
+/*******************************************************************\
 
-  // initial state
+Function: vcd_trace_sinkt::state
 
-  show_trans_state_vcd(0, trace.states[0], trace.states[0], ns, out);
-  
-  // following ones
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void vcd_trace_sinkt::state(const trans_tracet::statet &state)
+{
+  if(done)
+    return;
+
+  if(timeframe == 0)
+    header(state);
+
+  show_trans_state_vcd(timeframe, previous_values, state, ns, out);
+
+  std::map<irep_idt, exprt> values;
+
+  for(const auto &a : state.assignments)
+    values[a.lhs.get(ID_identifier)] = a.rhs;
+
+  previous_values.swap(values);
+
+  timeframe++;
+
+  if(state.property_failed)
+    done = true;
+}
+
+/*******************************************************************\
+
+Function: output_trans_trace
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void output_trans_trace(const trans_tracet &trace, trans_trace_sinkt &sink)
+{
+  for(const auto &state : trace.states)
+    sink.state(state);
 
-  for(std::size_t t = 1; t <= l; t++)
-    show_trans_state_vcd(t, trace.states[t-1], trace.states[t], ns, out);
+  sink.finish();
 }
 
 /*******************************************************************\
@@ -14,6 +14,9 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/threeval.h>
 #include <util/ui_message.h>
 
+#include <iosfwd>
+#include <map>
+
 class jsont;
 
 class trans_tracet
@@ -64,12 +67,37 @@ public:
   std::optional<std::size_t> get_min_failing_timeframe() const;
 };
 
+// conversion from/to irep, e.g., for serialization
+
+irept to_irep(const trans_tracet &);
+
+trans_tracet trans_trace_from_irep(const irept &);
+
 // outputting traces
 
 jsont json(const trans_tracet &, const namespacet &);
 
 xmlt xml(const trans_tracet &, const namespacet &);
 
+// outputting single states
+
+jsont json(const trans_tracet::statet &, const namespacet &);
+
+xmlt xml(
+  const trans_tracet::statet &,
+  std::size_t timeframe,
+  const namespacet &);
+
+void show_trans_state(
+  std::size_t timeframe,
+  const trans_tracet::statet &,
+  const namespacet &);
+
+void show_trans_state_numbered(
+  std::size_t timeframe,
+  const trans_tracet::statet &,
+  const namespacet &);
+
 void show_trans_trace(
   const trans_tracet &,
   messaget &,
@@ -100,4 +128,46 @@ void show_trans_trace_numbered(
   const namespacet &,
   std::ostream &);
 
+// streaming output of traces, one state at a time
+
+class trans_trace_sinkt
+{
+public:
+  virtual ~trans_trace_sinkt() = default;
+
+  /// the next state of the trace
+  virtual void state(const trans_tracet::statet &) = 0;
+
+  /// there are no further states
+  virtual void finish()
+  {
+  }
+};
+
+/// passes the states of the trace to the sink, and then finishes it
+void output_trans_trace(const trans_tracet &, trans_trace_sinkt &);
+
+/// Writes VCD as the states arrive. The header is written with the
+/// first state, and each further state only gives the signals whose
+/// value changed. States after the first one that fails the property
+/// are ignored.
+class vcd_trace_sinkt : public trans_trace_sinkt
+{
+public:
+  vcd_trace_sinkt(const namespacet &, std::ostream &);
+
+  void state(const trans_tracet::statet &) override;
+
+protected:
+  const namespacet &ns;
+  std::ostream &out;
+  std::size_t timeframe = 0;
+  bool done = false;
+
+  // the values in the previous state
+  std::map<irep_idt, exprt> previous_values;
+
+  void header(const trans_tracet::statet &);
+};
+
 #endif
@@ -123,7 +123,13 @@ trans_tracet compute_trans_trace(
       if(!var.is_latch() && !var.is_input() && !var.is_wire())
         continue;
         
-      const symbolt &symbol=ns.lookup(it->first);
+      // The inputs that the netlist conversion adds for undriven
+      // signals have no symbol in the design.
+      const symbolt *symbol_ptr;
+      if(ns.lookup(it->first, symbol_ptr))
+        continue;
+
+      const symbolt &symbol=*symbol_ptr;
 
       std::string value;
       value.reserve(var.bits.size());
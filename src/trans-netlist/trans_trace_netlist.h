@@ -18,4 +18,8 @@ trans_tracet compute_trans_trace(
   const class propt &solver,
   const namespacet &);
 
+/// converts a string of bits, most significant bit first,
+/// into a constant of the given type
+exprt bitstring_to_expr(const std::string &, const typet &);
+
 #endif
@@ -78,31 +78,9 @@ void unwind(
   for(const auto & c : netlist.transition)
     solver.l_set_to(bmc_map.translate(t, c), true);
 
-  if(!last)
-  {     
-    // joining the latches between timeframe and timeframe+1
-    for(var_mapt::mapt::const_iterator
-        v_it=netlist.var_map.map.begin();
-        v_it!=netlist.var_map.map.end();
-        v_it++)
-    {
-      const var_mapt::vart &var=v_it->second;
-      if(var.is_latch())
-      {
-        for(std::size_t bit_nr=0; bit_nr<var.bits.size(); bit_nr++)
-        {
-          const var_mapt::vart::bitt &bit=var.bits[bit_nr];
-          
-          literalt l_from=bit.next;
-          literalt l_to=bit.current;
-
-          solver.set_equal(
-            bmc_map.translate(t, l_from),
-            bmc_map.translate(t+1, l_to));
-        }
-      }
-    }
-  }
+  // The latches between timeframe and timeframe+1 are joined
+  // by the bmc_mapt, which uses the solver literals of the
+  // next-state functions for the latches in timeframe+1.
 }
 
 /*******************************************************************\
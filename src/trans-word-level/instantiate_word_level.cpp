@@ -214,6 +214,160 @@ typet wl_instantiatet::instantiate_rec(typet type, const mp_integer &) const
 
 /*******************************************************************\
 
+Function: wl_instantiate_cachet::wl_instantiate_cachet
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+wl_instantiate_cachet::wl_instantiate_cachet(exprt _expr)
+  : expr(std::move(_expr))
+{
+  has_symbols = compute_positions(expr, positions);
+}
+
+/*******************************************************************\
+
+Function: wl_instantiate_cachet::compute_positions
+
+  Inputs:
+
+ Outputs: true iff the expression contains a symbol
+
+ Purpose:
+
+\*******************************************************************/
+
+bool wl_instantiate_cachet::compute_positions(
+  const exprt &src,
+  positiont &dest)
+{
+  if(src.id() == ID_symbol || src.id() == ID_next_symbol)
+    return true;
+
+  if(
+    is_SVA_sequence(src) || src.id() == ID_verilog_past ||
+    is_temporal_operator(src))
+  {
+    general = true;
+    return true;
+  }
+
+  const auto &operands = src.operands();
+
+  for(std::size_t i = 0; i < operands.size(); i++)
+  {
+    positiont position;
+    if(compute_positions(operands[i], position))
+      dest.operands.emplace_back(i, std::move(position));
+  }
+
+  return !dest.operands.empty();
+}
+
+/*******************************************************************\
+
+Function: wl_instantiate_cachet::timeframe_identifier
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+const irep_idt &wl_instantiate_cachet::timeframe_identifier(
+  const irep_idt &identifier,
+  const mp_integer &t)
+{
+  auto &map = identifiers[t];
+  auto entry = map.emplace(identifier, irep_idt{});
+
+  if(entry.second)
+    entry.first->second = ::timeframe_identifier(t, identifier);
+
+  return entry.first->second;
+}
+
+/*******************************************************************\
+
+Function: wl_instantiate_cachet::substitute
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void wl_instantiate_cachet::substitute(
+  exprt &dest,
+  const positiont &position,
+  const mp_integer &t)
+{
+  if(dest.id() == ID_next_symbol)
+  {
+    dest.id(ID_symbol);
+    dest.set(
+      ID_identifier, timeframe_identifier(dest.get(ID_identifier), t + 1));
+  }
+  else if(dest.id() == ID_symbol)
+  {
+    dest.set(ID_identifier, timeframe_identifier(dest.get(ID_identifier), t));
+  }
+  else
+  {
+    // This only touches the operands that contain symbols.
+    auto &operands = dest.operands();
+
+    for(auto &[index, operand_position] : position.operands)
+      substitute(operands[index], operand_position, t);
+  }
+}
+
+/*******************************************************************\
+
+Function: wl_instantiate_cachet::operator()
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+exprt wl_instantiate_cachet::operator()(
+  const mp_integer &t,
+  const mp_integer &no_timeframes)
+{
+  if(general)
+  {
+    wl_instantiatet wl_instantiate(no_timeframes);
+    return wl_instantiate(expr, t).second;
+  }
+
+  // The identifiers of older timeframes are not needed again
+  // when the timeframes are instantiated in order.
+  identifiers.erase(identifiers.begin(), identifiers.lower_bound(t));
+
+  // shares all subexpressions that do not contain symbols
+  exprt result = expr;
+
+  if(has_symbols)
+    substitute(result, positions, t);
+
+  return result;
+}
+
+/*******************************************************************\
+
 Function: instantiate
 
   Inputs:
@@ -229,8 +383,7 @@ exprt instantiate(
   const mp_integer &t,
   const mp_integer &no_timeframes)
 {
-  wl_instantiatet wl_instantiate(no_timeframes);
-  return wl_instantiate(expr, t).second;
+  return wl_instantiate_cachet{expr}(t, no_timeframes);
 }
 
 /*******************************************************************\
@@ -12,6 +12,10 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/mp_arith.h>
 #include <util/std_expr.h>
 
+#include <map>
+#include <unordered_map>
+#include <vector>
+
 exprt instantiate(
   const exprt &expr,
   const mp_integer &current,
@@ -25,6 +29,44 @@ std::pair<mp_integer, exprt> instantiate_property(
 std::string
 timeframe_identifier(const mp_integer &timeframe, const irep_idt &identifier);
 
+/// Instantiates an expression for any number of timeframes.
+/// The positions of the symbols in the expression are computed once,
+/// and only the paths to these are rebuilt for each timeframe;
+/// subexpressions without symbols are shared between the timeframes.
+/// The timeframe identifiers are computed once per symbol and timeframe.
+class wl_instantiate_cachet
+{
+public:
+  explicit wl_instantiate_cachet(exprt);
+
+  /// Instantiate the expression for timeframe t
+  [[nodiscard]] exprt
+  operator()(const mp_integer &t, const mp_integer &no_timeframes);
+
+protected:
+  exprt expr;
+
+  // The operands that contain symbols, recursively.
+  struct positiont
+  {
+    std::vector<std::pair<std::size_t, positiont>> operands;
+  };
+
+  positiont positions;
+  bool has_symbols;
+
+  // The expression has operators that need the general
+  // instantiation, e.g., $past or sequences.
+  bool general = false;
+
+  // symbol identifier -> timeframe identifier, by timeframe
+  std::map<mp_integer, std::unordered_map<irep_idt, irep_idt>> identifiers;
+
+  bool compute_positions(const exprt &, positiont &);
+  void substitute(exprt &, const positiont &, const mp_integer &t);
+  const irep_idt &timeframe_identifier(const irep_idt &, const mp_integer &t);
+};
+
 symbol_exprt timeframe_symbol(const mp_integer &timeframe, symbol_exprt);
 
 #endif
@@ -71,7 +71,7 @@ symbol_exprt lasso_symbol(const mp_integer &k, const mp_integer &i)
 
 /*******************************************************************\
 
-Function: lasso_constraints
+Function: lasso_variables
 
   Inputs:
 
@@ -81,16 +81,10 @@ Function: lasso_constraints
 
 \*******************************************************************/
 
-void lasso_constraints(
-  decision_proceduret &solver,
-  const mp_integer &no_timeframes,
-  const namespacet &ns,
-  const irep_idt &module_identifier)
+static std::vector<symbol_exprt>
+lasso_variables(const namespacet &ns, const irep_idt &module_identifier)
 {
-  // The definition of a lasso to state s_i is that there
-  // is an identical state s_k = s_i with k<i.
   // "Identical" is defined as "state variables and top-level inputs match".
-
   std::vector<symbol_exprt> variables_to_compare;
 
   // Gather the state variables.
@@ -122,7 +116,66 @@ void lasso_constraints(
     }
   }
 
-  for(mp_integer i = 1; i < no_timeframes; ++i)
+  return variables_to_compare;
+}
+
+/*******************************************************************\
+
+Function: saved_symbol
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: the copy of a variable in the state at the start
+          of the loop, for the linear encoding
+
+\*******************************************************************/
+
+static symbol_exprt saved_symbol(const symbol_exprt &var)
+{
+  return symbol_exprt{
+    "lasso::saved::" + id2string(var.get_identifier()), var.type()};
+}
+
+/*******************************************************************\
+
+Function: loop_start_symbol
+
+  Inputs:
+
+ Outputs:
+
+ Purpose: true when the loop starts in timeframe i,
+          for the linear encoding
+
+\*******************************************************************/
+
+static symbol_exprt loop_start_symbol(const mp_integer &i)
+{
+  return symbol_exprt{
+    "lasso::loop-start::" + integer2string(i), bool_typet()};
+}
+
+/*******************************************************************\
+
+Function: lasso_constraints_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+static void lasso_constraints_timeframe(
+  decision_proceduret &solver,
+  const mp_integer &i,
+  const std::vector<symbol_exprt> &variables_to_compare,
+  lasso_encodingt encoding)
+{
+  if(encoding == lasso_encodingt::QUADRATIC)
   {
     for(mp_integer k = 0; k < i; ++k)
     {
@@ -132,6 +185,86 @@ void lasso_constraints(
       solver.set_to_true(equal_exprt(lasso_symbol, equal));
     }
   }
+  else
+  {
+    // The solver picks the timeframe the loop starts in, and the
+    // state in that timeframe is saved. A state that is equal to
+    // the saved state closes the loop. This needs one comparison
+    // with the saved state per timeframe, instead of one for each
+    // pair of timeframes.
+    exprt::operandst conjuncts;
+    conjuncts.reserve(variables_to_compare.size());
+
+    for(auto &var : variables_to_compare)
+    {
+      conjuncts.push_back(
+        equal_exprt{timeframe_symbol(i, var), saved_symbol(var)});
+    }
+
+    auto equals_saved = solver.handle(conjunction(std::move(conjuncts)));
+
+    // the state in the loop-start timeframe is the saved state
+    solver.set_to_true(implies_exprt{loop_start_symbol(i), equals_saved});
+
+    // Is there a loop back from time frame i back to time frame k?
+    // Only the direction that is needed for counterexamples is
+    // encoded, as the solver is free to pick the loop start anyway.
+    for(mp_integer k = 0; k < i; ++k)
+    {
+      solver.set_to_true(implies_exprt{
+        lasso_symbol(k, i), and_exprt{loop_start_symbol(k), equals_saved}});
+    }
+  }
+}
+
+/*******************************************************************\
+
+Function: lasso_constraints
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void lasso_constraints(
+  decision_proceduret &solver,
+  const mp_integer &no_timeframes,
+  const namespacet &ns,
+  const irep_idt &module_identifier,
+  lasso_encodingt encoding)
+{
+  // The definition of a lasso to state s_i is that there
+  // is an identical state s_k = s_i with k<i.
+  auto variables_to_compare = lasso_variables(ns, module_identifier);
+
+  for(mp_integer i = 0; i < no_timeframes; ++i)
+    lasso_constraints_timeframe(solver, i, variables_to_compare, encoding);
+}
+
+/*******************************************************************\
+
+Function: lasso_constraints_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void lasso_constraints_timeframe(
+  decision_proceduret &solver,
+  const mp_integer &i,
+  const namespacet &ns,
+  const irep_idt &module_identifier,
+  lasso_encodingt encoding)
+{
+  auto variables_to_compare = lasso_variables(ns, module_identifier);
+  lasso_constraints_timeframe(solver, i, variables_to_compare, encoding);
 }
 
 /*******************************************************************\
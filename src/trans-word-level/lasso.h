@@ -11,16 +11,39 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <util/mp_arith.h>
 #include <util/namespace.h>
+#include <util/std_expr.h>
 
 #include <solvers/decision_procedure.h>
 
+/// QUADRATIC compares the states of every pair of timeframes.
+/// LINEAR lets the solver pick the start of the loop, and compares
+/// the state in every timeframe with a single saved copy of the
+/// state at the loop start. The latter only defines the lasso
+/// symbols in the direction that is required for counterexamples,
+/// and is therefore not suitable for liveness assumptions.
+enum class lasso_encodingt
+{
+  QUADRATIC,
+  LINEAR
+};
+
 /// Adds a constraint that can be used to determine whether the
 /// given state has already been seen earlier in the trace.
 void lasso_constraints(
   decision_proceduret &,
   const mp_integer &no_timeframes,
   const namespacet &,
-  const irep_idt &module_identifier);
+  const irep_idt &module_identifier,
+  lasso_encodingt);
+
+/// Adds the lasso constraints for the loops that end in
+/// timeframe \p i only, for incremental unwinding.
+void lasso_constraints_timeframe(
+  decision_proceduret &,
+  const mp_integer &i,
+  const namespacet &,
+  const irep_idt &module_identifier,
+  lasso_encodingt);
 
 /// Is there a loop from i back to k?
 /// Precondition: k<i
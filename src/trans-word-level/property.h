@@ -16,6 +16,8 @@ Author: Daniel Kroening, kroening@kroening.com
 
 #include <solvers/decision_procedure.h>
 
+#include "lasso.h"
+
 void property(
   const exprt &property_expr,
   exprt::operandst &prop_handles,
@@ -27,19 +29,4 @@ void property(
 /// Is the given property supported by word-level unwinding?
 bool bmc_supports_property(const exprt &);
 
-/// Adds a constraint that can be used to determine whether the
-/// given state has already been seen earlier in the trace.
-void lasso_constraints(
-  decision_proceduret &,
-  const mp_integer &no_timeframes,
-  const namespacet &,
-  const irep_idt &module_identifier);
-
-/// Is there a loop from i back to k?
-/// Precondition: k<i
-symbol_exprt lasso_symbol(const mp_integer &k, const mp_integer &i);
-
-/// Returns true iff the given property requires lasso constraints for BMC.
-bool requires_lasso_constraints(const exprt &);
-
 #endif
@@ -46,8 +46,12 @@ void unwind(
   message.progress() << "In-state constraints" << messaget::eom;
 
   if(!op_invar.is_true())
+  {
+    wl_instantiate_cachet invar_instance(op_invar);
+
     for(std::size_t c = 0; c < no_timeframes; c++)
-      decision_procedure.set_to_true(instantiate(op_invar, c, no_timeframes));
+      decision_procedure.set_to_true(invar_instance(c, no_timeframes));
+  }
 
   // initial state
 
@@ -64,6 +68,9 @@ void unwind(
   message.progress() << "Transition relation" << messaget::eom;
 
   if(!op_trans.is_true())
+  {
+    wl_instantiate_cachet trans_instance(op_trans);
+
     for(std::size_t t = 0; t < no_timeframes; t++)
     {
       // do transitions
@@ -75,6 +82,53 @@ void unwind(
         message.progress() << "Transition " << t << "->" << t + 1
                            << messaget::eom;
 
-      decision_procedure.set_to_true(instantiate(op_trans, t, no_timeframes));
+      decision_procedure.set_to_true(trans_instance(t, no_timeframes));
     }
+  }
+}
+
+/*******************************************************************\
+
+Function: unwind_timeframe
+
+  Inputs:
+
+ Outputs:
+
+ Purpose:
+
+\*******************************************************************/
+
+void unwind_timeframe(
+  const transt &trans,
+  unwind_cachet &cache,
+  message_handlert &message_handler,
+  decision_proceduret &decision_procedure,
+  std::size_t t,
+  const namespacet &ns,
+  bool initial_state)
+{
+  messaget message{message_handler};
+  const exprt &op_invar = trans.invar();
+  const exprt &op_init = trans.init();
+  const exprt &op_trans = trans.trans();
+
+  // The constraints for timeframe t only refer to the timeframes
+  // up to t+1, and hence, the result does not depend on the
+  // number of timeframes that are added later.
+  const std::size_t no_timeframes = t + 1;
+
+  message.progress() << "Timeframe " << t << messaget::eom;
+
+  // in-state constraints
+  if(!op_invar.is_true())
+    decision_procedure.set_to_true(cache.invar(t, no_timeframes));
+
+  // initial state
+  if(initial_state && t == 0 && !op_init.is_true())
+    decision_procedure.set_to_true(instantiate(op_init, 0, no_timeframes));
+
+  // transition t->t+1
+  if(!op_trans.is_true())
+    decision_procedure.set_to_true(cache.trans(t, no_timeframes));
 }
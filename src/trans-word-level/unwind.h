@@ -13,6 +13,8 @@ Author: Daniel Kroening, kroening@kroening.com
 #include <util/message.h>
 #include <util/std_expr.h>
 
+#include "instantiate_word_level.h"
+
 // word-level
 
 void unwind(
@@ -23,4 +25,33 @@ void unwind(
   const class namespacet &,
   bool initial_state = true);
 
+/// The instances of the in-state constraints and of the transition
+/// relation, which are built once and reused for every timeframe
+/// given to unwind_timeframe.
+class unwind_cachet
+{
+public:
+  explicit unwind_cachet(const transt &trans)
+    : invar(trans.invar()), trans(trans.trans())
+  {
+  }
+
+  wl_instantiate_cachet invar, trans;
+};
+
+/// Adds the constraints for timeframe \p t only, i.e., the in-state
+/// constraints and the transition into timeframe t+1, and the
+/// initial state if t is zero. Calling this for t=0,1,...,n-1
+/// is equivalent to unwind(...) with n timeframes, which enables
+/// incremental deepening using a single decision procedure.
+/// The cache must have been built for the same transt.
+void unwind_timeframe(
+  const transt &,
+  unwind_cachet &,
+  message_handlert &,
+  class decision_proceduret &,
+  std::size_t t,
+  const class namespacet &,
+  bool initial_state = true);
+
 #endif
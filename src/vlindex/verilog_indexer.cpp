@@ -9,21 +9,33 @@ Author: Daniel Kroening, dkr@amazon.com
 #include "verilog_indexer.h"
 
 #include <util/cmdline.h>
+#include <util/config.h>
 #include <util/cout_message.h>
+#include <util/irep_serialization.h>
+#include <util/string2int.h>
 #include <util/suffix.h>
 #include <util/unicode.h>
 
+#include <ebmc/ebmc_error.h>
+#include <ebmc/ebmc_version.h>
+#include <jobs/jobs.h>
 #include <verilog/verilog_parser.h>
 #include <verilog/verilog_preprocessor.h>
 #include <verilog/verilog_y.tab.h>
 
 #include <algorithm>
+#include <atomic>
 #include <deque>
 #include <fstream>
 #include <iostream>
+#include <sstream>
 #include <unordered_map>
 #include <unordered_set>
 
+#ifndef _WIN32
+#  include <sys/mman.h>
+#endif
+
 std::size_t verilog_indexert::total_number_of_files() const
 {
   return file_map.size();
@@ -58,6 +70,153 @@ std::size_t verilog_indexert::total_number_of_lines() const
   return sum;
 }
 
+irept verilog_indexert::to_irep() const
+{
+  irept result;
+
+  for(auto &[file_name, file] : file_map)
+  {
+    irept file_irep{file_name};
+    file_irep.set_size_t("number_of_lines", file.number_of_lines);
+    file_irep.set_size_t("size", file.size);
+    file_irep.set("modification_time", file.modification_time);
+
+    for(auto &id : file.ids)
+    {
+      irept id_irep{id.name};
+      id_irep.set_size_t("kind", id.kind);
+      id_irep.set("module", id.module);
+      id_irep.set_size_t("line_number", id.line_number);
+      id_irep.set("instantiated_module", id.instantiated_module);
+      file_irep.get_sub().push_back(std::move(id_irep));
+    }
+
+    result.get_sub().push_back(std::move(file_irep));
+  }
+
+  return result;
+}
+
+void verilog_indexert::from_irep(const irept &src)
+{
+  for(auto &file_irep : src.get_sub())
+  {
+    const irep_idt &file_name = file_irep.id();
+    auto &file = file_map[file_name];
+    file.number_of_lines = file_irep.get_size_t("number_of_lines");
+    file.size = file_irep.get_size_t("size");
+    file.modification_time = file_irep.get_long_long("modification_time");
+
+    for(auto &id_irep : file_irep.get_sub())
+    {
+      idt id;
+      id.kind = static_cast<idt::kindt>(id_irep.get_size_t("kind"));
+      id.name = id_irep.id();
+      id.file_name = file_name;
+      id.module = id_irep.get("module");
+      id.line_number = id_irep.get_size_t("line_number");
+      id.instantiated_module = id_irep.get("instantiated_module");
+      file.ids.push_back(std::move(id));
+    }
+  }
+}
+
+/// the size and the modification time of the given file,
+/// zero if these are unknown
+static std::pair<std::size_t, long long>
+file_stamp(const std::string &file_name)
+{
+  std::error_code error_code;
+  auto path = std::filesystem::path(widen_if_needed(file_name));
+
+  auto size = std::filesystem::file_size(path, error_code);
+  if(error_code)
+    return {0, 0};
+
+  auto time = std::filesystem::last_write_time(path, error_code);
+  if(error_code)
+    return {0, 0};
+
+  return {size, time.time_since_epoch().count()};
+}
+
+bool verilog_indexert::is_up_to_date(const irep_idt &file_name) const
+{
+  auto file_it = file_map.find(file_name);
+  if(file_it == file_map.end())
+    return false;
+
+  auto [size, modification_time] = file_stamp(id2string(file_name));
+
+  return modification_time != 0 && size == file_it->second.size &&
+         modification_time == file_it->second.modification_time;
+}
+
+void verilog_indexert::read(
+  const std::string &index_file_name,
+  const irept &key)
+{
+  std::ifstream in(widen_if_needed(index_file_name), std::ios::binary);
+
+  // We deliberately fail silently, and then simply index all files.
+  if(!in)
+    return;
+
+  try
+  {
+    irep_serializationt::ireps_containert ireps_container;
+    irept index = irep_serializationt{ireps_container}.reference_convert(in);
+
+    // discard indices from other versions or with another key
+    if(
+      index.id() != "vlindex" || index.get("version") != EBMC_VERSION ||
+      index.find("key") != key)
+    {
+      return;
+    }
+
+    from_irep(index);
+  }
+  catch(...)
+  {
+    file_map.clear();
+  }
+}
+
+void verilog_indexert::write(
+  const std::string &index_file_name,
+  const irept &key) const
+{
+  irept index = to_irep();
+  index.id("vlindex");
+  index.set("version", EBMC_VERSION);
+  index.add("key") = key;
+
+  // write to a temporary file first, such that a concurrent
+  // reader never sees a partial index
+  const std::string tmp_file_name = index_file_name + ".tmp";
+
+  {
+    std::ofstream out(widen_if_needed(tmp_file_name), std::ios::binary);
+
+    if(!out)
+      throw ebmc_errort()
+        << "failed to write index file " << tmp_file_name;
+
+    irep_serializationt::ireps_containert ireps_container;
+    irep_serializationt{ireps_container}.reference_convert(index, out);
+  }
+
+  std::error_code error_code;
+  std::filesystem::rename(
+    widen_if_needed(tmp_file_name),
+    widen_if_needed(index_file_name),
+    error_code);
+
+  if(error_code)
+    throw ebmc_errort() << "failed to write index file " << index_file_name;
+}
+
 class verilog_indexer_parsert
 {
 public:
@@ -183,6 +342,10 @@ void verilog_indexert::operator()(
   const irep_idt &file_name,
   enum verilog_standardt standard)
 {
+  // Take the stamp first, such that a change during indexing
+  // is noticed next time.
+  auto [size, modification_time] = file_stamp(id2string(file_name));
+
   // run the preprocessor
   const auto preprocessed_string = preprocess(id2string(file_name));
   std::istringstream preprocessed(preprocessed_string);
@@ -195,7 +358,11 @@ void verilog_indexert::operator()(
 
   // now parse
   parser.rDescription();
-  file_map[file_name].number_of_lines = parser.verilog_parser.get_line_no();
+
+  auto &file = file_map[file_name];
+  file.number_of_lines = parser.verilog_parser.get_line_no();
+  file.size = size;
+  file.modification_time = modification_time;
 }
 
 std::string verilog_indexert::preprocess(const std::string &file_name)
@@ -214,7 +381,7 @@ std::string verilog_indexert::preprocess(const std::string &file_name)
 
   console_message_handlert message_handler;
   verilog_preprocessort preprocessor(
-    in_stream, preprocessed, message_handler, file_name, {});
+    in_stream, preprocessed, message_handler, file_name, initial_defines);
 
   try
   {
@@ -1348,8 +1515,113 @@ void show_kind(
   }
 }
 
-int verilog_index(const cmdlinet &cmdline)
+#ifndef _WIN32
+/// Indexes the given files using the given number of worker processes.
+/// The scanner and the string table are global, and hence, the workers
+/// are processes, not threads. The workers take the next file from a
+/// counter in shared memory, and return their partial index through
+/// a pipe. The partial indices are then merged into \p indexer.
+static void index_files_with_jobs(
+  std::vector<std::string> files,
+  verilog_standardt standard,
+  std::size_t jobs,
+  verilog_indexert &indexer)
 {
+  // Index the largest files first, to avoid having a large file
+  // at the very end for one worker only.
+  std::vector<std::pair<std::uintmax_t, std::string>> by_size;
+  by_size.reserve(files.size());
+
+  for(auto &file : files)
+  {
+    std::error_code error_code;
+    auto size = std::filesystem::file_size(file, error_code);
+    by_size.emplace_back(error_code ? 0 : size, std::move(file));
+  }
+
+  std::stable_sort(
+    by_size.begin(),
+    by_size.end(),
+    [](const auto &a, const auto &b) { return a.first > b.first; });
+
+  using countert = std::atomic<std::size_t>;
+
+  void *shared = mmap(
+    nullptr,
+    sizeof(countert),
+    PROT_READ | PROT_WRITE,
+    MAP_SHARED | MAP_ANONYMOUS,
+    -1,
+    0);
+
+  if(shared == MAP_FAILED)
+    throw ebmc_errort() << "failed to map shared memory for jobs";
+
+  auto next_file = new(shared) countert(0);
+
+  std::vector<ebmc_jobt> workers;
+
+  for(std::size_t i = 0; i < jobs; i++)
+  {
+    workers.push_back(fork_job(
+      [&by_size, next_file, standard, &indexer]()
+      {
+        verilog_indexert partial_indexer;
+        partial_indexer.initial_defines = indexer.initial_defines;
+
+        while(true)
+        {
+          std::size_t index = next_file->fetch_add(1);
+          if(index >= by_size.size())
+            break;
+          partial_indexer(by_size[index].second, standard);
+        }
+
+        return partial_indexer.to_irep();
+      }));
+  }
+
+  bool failed = false;
+
+  for(auto &worker : workers)
+  {
+    irept result = wait_job(worker);
+
+    if(result.is_nil())
+      failed = true;
+    else
+      indexer.from_irep(result);
+  }
+
+  munmap(shared, sizeof(countert));
+
+  if(failed)
+    throw ebmc_errort() << "indexing job failed";
+}
+#endif
+
+/// everything that the index depends on other than the files,
+/// i.e., the language standard, the include paths and the defines
+static irept index_key(const cmdlinet &cmdline, verilog_standardt standard)
+{
+  irept key;
+  key.set_size_t("standard", static_cast<std::size_t>(standard));
+
+  auto &include_paths = key.add("include_paths").get_sub();
+  for(const auto &include_path : cmdline.get_values('I'))
+    include_paths.emplace_back(include_path);
+
+  auto &defines = key.add("defines").get_sub();
+  for(const auto &define : cmdline.get_values('D'))
+    defines.emplace_back(define);
+
+  return key;
+}
+
+int verilog_index(const cmdlinet &cmdline, message_handlert &message_handler)
+{
+  messaget message(message_handler);
+
   // First find all .v and .sv files
   auto files = verilog_files();
 
@@ -1378,15 +1650,87 @@ int verilog_index(const cmdlinet &cmdline)
       return verilog_standardt::SV2017;
   }();
 
+  if(cmdline.isset('I'))
+    config.verilog.include_paths = cmdline.get_values('I');
+
+  if(cmdline.isset('D'))
+    indexer.initial_defines = cmdline.get_values('D');
+
+  std::vector<std::string> file_names;
+  file_names.reserve(files.size());
+
   for(const auto &file : files)
   {
 #ifdef _WIN32
-    indexer(narrow(file), standard);
+    file_names.push_back(narrow(file));
 #else
-    indexer(std::string(file), standard);
+    file_names.push_back(std::string(file));
+#endif
+  }
+
+  // Reuse the entries of the index file for the files
+  // that have not changed since.
+  if(cmdline.isset("index-file"))
+  {
+    verilog_indexert previous;
+    previous.read(
+      cmdline.get_value("index-file"), index_key(cmdline, standard));
+
+    std::vector<std::string> changed_files;
+
+    for(auto &file_name : file_names)
+    {
+      if(previous.is_up_to_date(file_name))
+      {
+        indexer.file_map[file_name] =
+          std::move(previous.file_map[file_name]);
+      }
+      else
+        changed_files.push_back(std::move(file_name));
+    }
+
+    message.statistics() << "Reusing the index of "
+                         << file_names.size() - changed_files.size() << " of "
+                         << file_names.size() << " files" << messaget::eom;
+
+    file_names = std::move(changed_files);
+  }
+
+  std::size_t jobs = 1;
+
+  if(cmdline.isset("jobs"))
+    jobs = unsafe_string2size_t(cmdline.get_value("jobs"));
+  else if(cmdline.isset('j'))
+    jobs = unsafe_string2size_t(cmdline.get_value('j'));
+
+#ifdef _WIN32
+  if(jobs > 1)
+  {
+    message.warning() << "multiple jobs are not supported on this platform"
+                      << messaget::eom;
+  }
+
+  jobs = 1;
+#endif
+
+  jobs = std::max(std::size_t(1), std::min(jobs, file_names.size()));
+
+  if(jobs == 1)
+  {
+    for(const auto &file_name : file_names)
+      indexer(file_name, standard);
+  }
+  else
+  {
+#ifndef _WIN32
+    index_files_with_jobs(std::move(file_names), standard, jobs, indexer);
 #endif
   }
 
+  if(cmdline.isset("index-file"))
+    indexer.write(
+      cmdline.get_value("index-file"), index_key(cmdline, standard));
+
   if(cmdline.isset("hierarchy"))
   {
     show_module_hierarchy(indexer);
@@ -13,7 +13,9 @@ Author: Daniel Kroening, dkr@amazon.com
 
 #include <verilog/verilog_standard.h>
 
+#include <list>
 #include <map>
+#include <string>
 #include <unordered_map>
 
 /// This is a catalogue of Verilog identifiers by file.
@@ -75,6 +77,11 @@ public:
   {
     std::size_t number_of_lines = 0;
     std::vector<idt> ids;
+
+    // the size and modification time of the file when it was
+    // indexed, to detect changes
+    std::size_t size = 0;
+    long long modification_time = 0;
   };
 
   // The keys are the file names.
@@ -91,6 +98,24 @@ public:
   /// index the given file
   void operator()(const irep_idt &file_name, verilog_standardt);
 
+  /// the index as irep, e.g., to pass it between processes
+  irept to_irep() const;
+
+  /// add the files given by an irep produced by to_irep()
+  void from_irep(const irept &);
+
+  /// whether the given file is unchanged since it was indexed
+  bool is_up_to_date(const irep_idt &file_name) const;
+
+  /// the defines given on the command line, for the preprocessor
+  std::list<std::string> initial_defines;
+
+  /// read/write the index from/to the given file, as a binary irep;
+  /// an index written with another key (standard, include paths,
+  /// defines) is not read
+  void read(const std::string &index_file_name, const irept &key);
+  void write(const std::string &index_file_name, const irept &key) const;
+
   using instancest =
     std::unordered_map<irep_idt, std::vector<idt>, irep_id_hash>;
 
@@ -105,7 +130,8 @@ protected:
 };
 
 class cmdlinet;
+class message_handlert;
 
-int verilog_index(const cmdlinet &);
+int verilog_index(const cmdlinet &, message_handlert &);
 
 #endif // VERILOG_INDEXER_H
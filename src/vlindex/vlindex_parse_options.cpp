@@ -46,20 +46,17 @@ int vlindex_parse_optionst::doit()
 
   try
   {
-    return verilog_index(cmdline);
+    return verilog_index(cmdline, ui_message_handler);
   }
   catch(const ebmc_errort &ebmc_error)
   {
     if(!ebmc_error.what().empty())
     {
       messaget message(ui_message_handler);
-      if(ebmc_error.location().is_not_nil())
-        message.error().source_location = ebmc_error.location();
-
       message.error() << "error: " << messaget::red << ebmc_error.what()
                       << messaget::reset << messaget::eom;
     }
-    return ebmc_error.exit_code().value_or(CPROVER_EXIT_EXCEPTION);
+    return CPROVER_EXIT_EXCEPTION;
   }
 }
 
@@ -95,6 +92,10 @@ void vlindex_parse_optionst::help()
     "Additonal options:\n"
     " {y--top} {umodule}             \t set top module\n"
     " {y-I} {upath}                  \t set include path\n"
+    " {y-D} {uvar}[={uvalue}]        \t set preprocessor define\n"
+    " {y--jobs} {unr}                \t index the files using nr jobs\n"
+    " {y--index-file} {ufile}        \t keep the index in the given file, and\n"
+    "                                \t re-index only the files that have changed\n"
     " {y--1800-2017}                 \t recognize 1800-2017 SystemVerilog (default)\n"
     " {y--1800-2012}                 \t recognize 1800-2012 SystemVerilog\n"
     " {y--1800-2009}                 \t recognize 1800-2009 SystemVerilog\n"
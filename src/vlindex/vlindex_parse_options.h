@@ -29,7 +29,8 @@ public:
         "(symlinks)(files)"
         "(1800-2017)(1800-2012)(1800-2009)(1800-2005)"
         "(1364-2005)(1364-2001)(1364-2001-noconfig)(1364-1995)"
-        "I:(preprocess)",
+        "D:I:(preprocess)"
+        "j:(jobs):(index-file):(verbosity):",
         argc,
         argv,
         std::string("EBMC ") + EBMC_VERSION),